@@ -0,0 +1,193 @@
+/**
+ * @file arrow_output.cpp
+ * @author Matteo Loporchio
+ * @brief Apache Arrow IPC and Parquet writers for the component map
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#include "arrow_output.hpp"
+
+#ifdef HAVE_ARROW
+
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <arrow/ipc/writer.h>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <unistd.h>
+#include <vector>
+
+#ifdef HAVE_PARQUET
+#include <parquet/arrow/writer.h>
+#endif
+
+using namespace std;
+
+/**
+ * @brief Returns the schema of the output table
+ */
+static shared_ptr<arrow::Schema> comp_map_schema() {
+    return arrow::schema({arrow::field("node_id", arrow::uint32(), false),
+        arrow::field("comp_id", arrow::uint32(), false)});
+}
+
+/**
+ * @brief Wraps a range of 32-bit integers into an Arrow array, without copying it
+ *
+ * @param data pointer to the first integer
+ * @param length number of integers
+ */
+static shared_ptr<arrow::Array> wrap_uint32(const uint32_t *data, int64_t length) {
+    auto buffer = make_shared<arrow::Buffer>((const uint8_t *) data, length * sizeof(uint32_t));
+    return arrow::MakeArray(arrow::ArrayData::Make(arrow::uint32(), length, {nullptr, buffer}, 0));
+}
+
+/**
+ * @brief Writes the component map as a sequence of record batches
+ *
+ * The node identifiers of each batch are materialized in a buffer reused
+ * across batches, since the writer has consumed a batch when write_batch returns.
+ * If some nodes are filtered out, the component identifiers are gathered in
+ * a second buffer; otherwise, they are taken directly from the component map.
+ *
+ * @param comp_map the component map
+ * @param batch_rows number of rows of each record batch
+ * @param filter selects the nodes to write (NULL for all nodes)
+ * @param write_batch function writing a record batch
+ * @return the status of the first failed write, or OK
+ */
+template <typename F>
+static arrow::Status write_batches(const comp_map_t &comp_map, size_t batch_rows,
+    const node_filter_t *filter, F write_batch) {
+    auto schema = comp_map_schema();
+    vector<uint32_t> node_ids(batch_rows), comp_ids;
+    if (filter && filter->sizes) comp_ids.resize(batch_rows);
+    size_t next = 0;
+    while (next < comp_map.size()) {
+        size_t length = 0;
+        const uint32_t *batch_comp_ids = comp_ids.data();
+        if (comp_ids.empty()) {
+            length = min(batch_rows, comp_map.size() - next);
+            iota(node_ids.begin(), node_ids.begin() + length, (uint32_t) next);
+            batch_comp_ids = comp_map.data() + next;
+            next += length;
+        }
+        else {
+            for (; next < comp_map.size() && length < batch_rows; next++) {
+                if (!node_selected(filter, comp_map[next])) continue;
+                node_ids[length] = next;
+                comp_ids[length++] = comp_map[next];
+            }
+            if (length == 0) break;
+        }
+        auto batch = arrow::RecordBatch::Make(schema, length,
+            {wrap_uint32(node_ids.data(), length), wrap_uint32(batch_comp_ids, length)});
+        ARROW_RETURN_NOT_OK(write_batch(*batch));
+    }
+    return arrow::Status::OK();
+}
+
+/**
+ * @brief Writes the component map as an Arrow IPC file
+ *
+ * @param fd descriptor of the output file
+ * @param comp_map the component map
+ * @param batch_rows number of rows of each record batch
+ * @param filter selects the nodes to write
+ */
+static arrow::Status write_arrow_ipc_status(int fd, const comp_map_t &comp_map, size_t batch_rows,
+    const node_filter_t *filter) {
+    // The stream owns its descriptor, so give it a duplicate.
+    ARROW_ASSIGN_OR_RAISE(auto sink, arrow::io::FileOutputStream::Open(dup(fd)));
+    ARROW_ASSIGN_OR_RAISE(auto writer, arrow::ipc::MakeFileWriter(sink, comp_map_schema()));
+    ARROW_RETURN_NOT_OK(write_batches(comp_map, batch_rows, filter, [&](const arrow::RecordBatch &batch) {
+        return writer->WriteRecordBatch(batch);
+    }));
+    ARROW_RETURN_NOT_OK(writer->Close());
+    return sink->Close();
+}
+
+bool arrow_supported() {
+    return true;
+}
+
+bool write_arrow_ipc(int fd, const comp_map_t &comp_map, size_t batch_rows,
+    const node_filter_t *filter) {
+    arrow::Status status = write_arrow_ipc_status(fd, comp_map, batch_rows, filter);
+    if (!status.ok()) cerr << "Arrow error: " << status.ToString() << '\n';
+    return status.ok();
+}
+
+#ifdef HAVE_PARQUET
+
+/**
+ * @brief Writes the component map as a Parquet file
+ *
+ * @param fd descriptor of the output file
+ * @param comp_map the component map
+ * @param batch_rows number of rows of each row group
+ * @param filter selects the nodes to write
+ */
+static arrow::Status write_parquet_status(int fd, const comp_map_t &comp_map, size_t batch_rows,
+    const node_filter_t *filter) {
+    ARROW_ASSIGN_OR_RAISE(auto sink, arrow::io::FileOutputStream::Open(dup(fd)));
+    auto properties = parquet::WriterProperties::Builder().max_row_group_length(batch_rows)->build();
+    ARROW_ASSIGN_OR_RAISE(auto writer, parquet::arrow::FileWriter::Open(*comp_map_schema(),
+        arrow::default_memory_pool(), sink, properties));
+    ARROW_RETURN_NOT_OK(write_batches(comp_map, batch_rows, filter, [&](const arrow::RecordBatch &batch) {
+        ARROW_RETURN_NOT_OK(writer->NewBufferedRowGroup());
+        return writer->WriteRecordBatch(batch);
+    }));
+    ARROW_RETURN_NOT_OK(writer->Close());
+    return sink->Close();
+}
+
+bool parquet_supported() {
+    return true;
+}
+
+bool write_parquet(int fd, const comp_map_t &comp_map, size_t batch_rows,
+    const node_filter_t *filter) {
+    arrow::Status status = write_parquet_status(fd, comp_map, batch_rows, filter);
+    if (!status.ok()) cerr << "Parquet error: " << status.ToString() << '\n';
+    return status.ok();
+}
+
+#else
+
+bool parquet_supported() {
+    return false;
+}
+
+bool write_parquet(int fd, const comp_map_t &comp_map, size_t batch_rows,
+    const node_filter_t *filter) {
+    return false;
+}
+
+#endif
+
+#else
+
+bool arrow_supported() {
+    return false;
+}
+
+bool parquet_supported() {
+    return false;
+}
+
+bool write_arrow_ipc(int fd, const comp_map_t &comp_map, size_t batch_rows,
+    const node_filter_t *filter) {
+    return false;
+}
+
+bool write_parquet(int fd, const comp_map_t &comp_map, size_t batch_rows,
+    const node_filter_t *filter) {
+    return false;
+}
+
+#endif
@@ -0,0 +1,68 @@
+/**
+ * @file arrow_output.hpp
+ * @author Matteo Loporchio
+ * @brief Apache Arrow IPC and Parquet writers for the component map
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Both writers produce a table with two unsigned 32-bit columns,
+ * node_id and comp_id, split into record batches (or Parquet row groups)
+ * of a configurable number of rows.
+ *
+ * The writers are only available if the program has been built with
+ * the Arrow library (HAVE_ARROW) and, for Parquet, with the Parquet
+ * library (HAVE_PARQUET); see the makefile. Otherwise they fail.
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#ifndef ARROW_OUTPUT_HPP
+#define ARROW_OUTPUT_HPP
+
+#include <cstddef>
+
+#include "components.hpp"
+#include "output.hpp"
+
+/// @brief Default number of rows of each record batch
+#define ARROW_BATCH_ROWS (1 << 20)
+
+/**
+ * @brief Tells whether the Arrow IPC writer is available in this build
+ */
+bool arrow_supported();
+
+/**
+ * @brief Tells whether the Parquet writer is available in this build
+ */
+bool parquet_supported();
+
+/**
+ * @brief Writes the component map as an Arrow IPC file (also known as Feather V2)
+ *
+ * Unless a filter is given, the comp_id column of each record batch points
+ * directly into the component map, so the component identifiers are never
+ * copied before being written.
+ *
+ * @param fd descriptor of the (already opened) output file, which is left open
+ * @param comp_map the component map
+ * @param batch_rows number of rows of each record batch
+ * @param filter selects the nodes to write (NULL for all nodes)
+ * @return true on success, false on error
+ */
+bool write_arrow_ipc(int fd, const comp_map_t &comp_map, size_t batch_rows,
+    const node_filter_t *filter = NULL);
+
+/**
+ * @brief Writes the component map as a Parquet file
+ *
+ * @param fd descriptor of the (already opened) output file, which is left open
+ * @param comp_map the component map
+ * @param batch_rows number of rows of each row group
+ * @param filter selects the nodes to write (NULL for all nodes)
+ * @return true on success, false on error
+ */
+bool write_parquet(int fd, const comp_map_t &comp_map, size_t batch_rows,
+    const node_filter_t *filter = NULL);
+
+#endif
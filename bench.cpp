@@ -0,0 +1,402 @@
+/**
+ * @file bench.cpp
+ * @author Matteo Loporchio
+ * @brief Microbenchmarks for the kernels of the builder and of the analyzer
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * This program runs a set of kernels on synthetic inputs and prints
+ * one tab-separated line per kernel variant with the following values:
+ *
+ * 1)   kernel and variant names;
+ * 2)   average time per operation in nanoseconds;
+ * 3)   throughput in millions of operations per second;
+ * 4)   throughput in megabytes per second (of input processed);
+ * 5)   relative standard deviation of the run times, in percent;
+ * 6)   cache miss rate (cache misses / cache references);
+ * 7)   cache misses per operation.
+ *
+ * The kernels cover the whole pipeline: parsing of the transactions
+ * (process_line and process_inputs), sorting and deduplication of the edges,
+ * writing and reading of the graph file and the connected components engines.
+ * Transactions are generated as a synthetic chain (see synthetic.hpp),
+ * while graphs have uniformly distributed edges.
+ *
+ * Hardware counters are reported as "n/a" if perf_event_open is not permitted.
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "components.hpp"
+#include "csr.hpp"
+#include "graph_file.hpp"
+#include "igraph_engine.hpp"
+#include "parallel.hpp"
+#include "perf_counters.hpp"
+#include "synthetic.hpp"
+#include "transactions.hpp"
+
+using namespace std;
+using namespace std::chrono;
+
+/// @brief Benchmark parameters
+typedef struct {
+    uint32_t num_nodes;     ///< number of nodes of the synthetic graphs
+    uint64_t num_edges;     ///< number of edges of the synthetic graphs
+    uint64_t num_tx;        ///< number of synthetic transactions
+    int repetitions;        ///< number of timed runs of each kernel
+    int num_threads;        ///< number of threads of the parallel kernels
+    string kernels;         ///< comma-separated list of kernels to run (empty for all)
+} bench_config_t;
+
+/// @brief Hardware counters shared by all benchmarks
+static perf_counters_t counters;
+
+/**
+ * @brief Runs a kernel several times and prints its average cost per operation
+ *
+ * @param kernel name of the kernel
+ * @param variant name of the variant
+ * @param num_ops number of operations performed by each run
+ * @param num_bytes number of bytes processed by each run
+ * @param repetitions number of runs
+ * @param setup function called (untimed) before each run
+ * @param run the kernel
+ */
+static void measure(const string &kernel, const string &variant, uint64_t num_ops, uint64_t num_bytes,
+    int repetitions, function<void()> setup, function<void()> run) {
+    double total_ns = 0, total_sq_ns = 0, references = 0, misses = 0;
+    for (int r = 0; r < repetitions; r++) {
+        setup();
+        perf_start(&counters);
+        auto start = high_resolution_clock::now();
+        run();
+        auto end = high_resolution_clock::now();
+        perf_stop(&counters);
+        double ns = duration_cast<nanoseconds>(end - start).count();
+        total_ns += ns;
+        total_sq_ns += ns * ns;
+        references += counters.values[PERF_CACHE_REFERENCES];
+        misses += counters.values[PERF_CACHE_MISSES];
+    }
+    double mean_ns = total_ns / repetitions;
+    double stddev_ns = sqrt(max(0.0, total_sq_ns / repetitions - mean_ns * mean_ns));
+    double ns_per_op = mean_ns / num_ops;
+    cout << kernel << '\t' << variant << '\t' << ns_per_op << '\t' << 1e3 / ns_per_op << '\t'
+        << num_bytes * 1e3 / mean_ns << '\t' << 100 * stddev_ns / mean_ns << '\t';
+    if (perf_available(&counters, PERF_CACHE_MISSES) && perf_available(&counters, PERF_CACHE_REFERENCES)) {
+        cout << ((references > 0) ? misses / references : 0) << '\t' << misses / repetitions / num_ops << '\n';
+    }
+    else cout << "n/a\tn/a\n";
+}
+
+/**
+ * @brief Tells whether a kernel has been selected with the -k option
+ *
+ * @param config benchmark parameters
+ * @param kernel name of the kernel
+ */
+static bool selected(const bench_config_t &config, const string &kernel) {
+    if (config.kernels.empty()) return true;
+    string list = "," + config.kernels + ",";
+    return list.find("," + kernel + ",") != string::npos;
+}
+
+/**
+ * @brief Generates a chain of synthetic transactions (see synthetic.hpp)
+ *
+ * @param num_tx number of transactions
+ * @param text receives the transactions, one per line
+ */
+static void random_transactions(uint64_t num_tx, string &text) {
+    chain_generator_t chain;
+    chain_init(&chain, 42);
+    char line[SYNTHETIC_MAX_LINE];
+    text.clear();
+    for (uint64_t t = 0; t < num_tx; t++) text.append(line, chain_next(&chain, line));
+}
+
+/**
+ * @brief Splits a text into NUL-terminated lines
+ *
+ * @param text the text, modified in place
+ * @param lines receives the offset of each line
+ */
+static void split_lines(string &text, vector<size_t> &lines) {
+    lines.clear();
+    size_t begin = 0, end;
+    while ((end = text.find('\n', begin)) != string::npos) {
+        text[end] = '\0';
+        lines.push_back(begin);
+        begin = end + 1;
+    }
+}
+
+/**
+ * @brief Generates a random graph with uniformly distributed edges
+ *
+ * @param num_nodes number of nodes
+ * @param num_edges number of edges
+ * @param edges receives the (source, target) pairs
+ */
+static void random_edges(uint32_t num_nodes, uint64_t num_edges, vector<uint32_t> &edges) {
+    mt19937_64 gen(42);
+    uniform_int_distribution<uint32_t> dist(0, num_nodes - 1);
+    edges.resize(2 * num_edges);
+    for (size_t i = 0; i < edges.size(); i++) edges[i] = dist(gen);
+}
+
+/**
+ * @brief Benchmarks the sequential union-find, with and without batching and prefetching
+ *
+ * @param config benchmark parameters
+ */
+static void bench_union_find(const bench_config_t &config) {
+    vector<uint32_t> edges;
+    random_edges(config.num_nodes, config.num_edges, edges);
+    comp_map_t parent;
+    const int batch_sizes[] = {0, 4, 8, 16, 32, 64};
+    for (int batch_size : batch_sizes) {
+        string variant = (batch_size == 0) ? "naive" : "batch" + to_string(batch_size);
+        measure("union_find", variant, config.num_edges, config.num_edges * 2 * sizeof(uint32_t), config.repetitions,
+            [&]() { uf_init(parent, config.num_nodes); },
+            [&]() { uf_union_edges(parent.data(), edges.data(), config.num_edges, batch_size); });
+    }
+}
+
+/**
+ * @brief Benchmarks the transaction parser on whole lines and on input lists
+ *
+ * @param config benchmark parameters
+ */
+static void bench_parser(const bench_config_t &config) {
+    string text, work;
+    vector<size_t> lines;
+    random_transactions(config.num_tx, text);
+    size_t num_bytes = text.size();
+    split_lines(text, lines);
+    // Extract the input lists of the transactions (i.e., their second field).
+    string inputs;
+    vector<size_t> input_lists;
+    for (size_t offset : lines) {
+        const char *line = text.c_str() + offset;
+        const char *begin = strchr(line, ':') + 1, *end = strchr(begin, ':');
+        if (begin == end) continue;
+        input_lists.push_back(inputs.size());
+        inputs.append(begin, end - begin);
+        inputs += '\0';
+    }
+    edge_list_t edges;
+    int max_id;
+    auto reset = [&](const string &source) {
+        work = source;
+        edge_list_t().swap(edges);
+        max_id = 0;
+    };
+    measure("parse", "process_line", lines.size(), num_bytes, config.repetitions,
+        [&]() { reset(text); },
+        [&]() { for (size_t offset : lines) process_line(&work[offset], &max_id, edges); });
+    measure("parse", "process_inputs", input_lists.size(), inputs.size(), config.repetitions,
+        [&]() { reset(inputs); },
+        [&]() { for (size_t offset : input_lists) process_inputs(&work[offset], &max_id, edges); });
+}
+
+/**
+ * @brief Benchmarks sorting and deduplication of the edges produced by the parser
+ *
+ * @param config benchmark parameters
+ */
+static void bench_sort(const bench_config_t &config) {
+    string text;
+    vector<size_t> lines;
+    random_transactions(config.num_tx, text);
+    split_lines(text, lines);
+    edge_list_t parsed, edges;
+    int max_id = 0;
+    for (size_t offset : lines) process_line(&text[offset], &max_id, parsed);
+    uint64_t num_bytes = parsed.size() * sizeof(parsed[0]);
+    if (selected(config, "sort")) {
+        measure("sort", "std_sort", parsed.size(), num_bytes, config.repetitions,
+            [&]() { edges = parsed; },
+            [&]() { sort(edges.begin(), edges.end()); });
+    }
+    if (selected(config, "dedup")) {
+        edge_list_t sorted(parsed);
+        sort(sorted.begin(), sorted.end());
+        measure("dedup", "unique", sorted.size(), num_bytes, config.repetitions,
+            [&]() { edges = sorted; },
+            [&]() { edges.erase(unique(edges.begin(), edges.end()), edges.end()); });
+    }
+}
+
+/**
+ * @brief Converts a random graph into a sorted edge list without duplicates
+ *
+ * @param config benchmark parameters
+ * @param edges receives the edge list
+ */
+static void random_edge_list(const bench_config_t &config, edge_list_t &edges) {
+    vector<uint32_t> pairs;
+    random_edges(config.num_nodes, config.num_edges, pairs);
+    edges.resize(config.num_edges);
+    for (size_t i = 0; i < edges.size(); i++) edges[i] = minmax((int) pairs[2*i], (int) pairs[2*i+1]);
+    sort(edges.begin(), edges.end());
+    edges.erase(unique(edges.begin(), edges.end()), edges.end());
+}
+
+/**
+ * @brief Benchmarks writing and reading the graph file (a temporary file)
+ *
+ * @param config benchmark parameters
+ */
+static void bench_graph_file(const bench_config_t &config) {
+    edge_list_t edge_list;
+    random_edge_list(config, edge_list);
+    uint64_t num_edges = edge_list.size(), num_bytes = 8 + num_edges * 8;
+    FILE *graph_file = tmpfile();
+    if (!graph_file) {
+        cerr << "Warning: could not create a temporary file, skipping the graph file benchmarks!\n";
+        return;
+    }
+    if (selected(config, "write")) {
+        measure("write", "write_graph", num_edges, num_bytes, config.repetitions,
+            [&]() { rewind(graph_file); },
+            [&]() { write_graph(graph_file, config.num_nodes, edge_list); fflush(graph_file); });
+    }
+    if (selected(config, "read")) {
+        // The read kernels need the file, whether or not it was written by the write kernel.
+        rewind(graph_file);
+        write_graph(graph_file, config.num_nodes, edge_list);
+        fflush(graph_file);
+        vector<uint32_t> edges;
+        measure("read", "read_all_edges", num_edges, num_bytes, config.repetitions,
+            [&]() { fseek(graph_file, 8, SEEK_SET); edges.clear(); },
+            [&]() { read_all_edges(graph_file, edges, num_edges); });
+        igraph_t graph;
+        measure("read", "read_graph_binary", num_edges, num_bytes, config.repetitions,
+            [&]() { fseek(graph_file, 8, SEEK_SET); },
+            [&]() { read_graph_binary(&graph, graph_file, config.num_nodes, num_edges); igraph_destroy(&graph); });
+    }
+    fclose(graph_file);
+}
+
+/**
+ * @brief Benchmarks the connected components engines on a random graph
+ *
+ * @param config benchmark parameters
+ */
+static void bench_components(const bench_config_t &config) {
+    edge_list_t edge_list;
+    random_edge_list(config, edge_list);
+    uint64_t num_edges = edge_list.size(), num_bytes = num_edges * 2 * sizeof(uint32_t);
+    FILE *graph_file = tmpfile();
+    if (!graph_file) {
+        cerr << "Warning: could not create a temporary file, skipping the components benchmarks!\n";
+        return;
+    }
+    write_graph(graph_file, config.num_nodes, edge_list);
+    fflush(graph_file);
+    comp_map_t comp_map;
+    uint32_t num_cc;
+    uint64_t edges_read;
+    // The igraph graph is built once, outside the timed region.
+    igraph_t graph;
+    fseek(graph_file, 8, SEEK_SET);
+    read_graph_binary(&graph, graph_file, config.num_nodes, num_edges);
+    measure("cc", "igraph", num_edges, num_bytes, config.repetitions, []() {},
+        [&]() { cc_igraph(&graph, comp_map, &num_cc); });
+    igraph_destroy(&graph);
+    measure("cc", "uf_stream", num_edges, num_bytes, config.repetitions,
+        [&]() { fseek(graph_file, 8, SEEK_SET); },
+        [&]() { cc_union_find(graph_file, config.num_nodes, 16, comp_map, &num_cc, &edges_read); });
+    vector<uint32_t> edges;
+    fseek(graph_file, 8, SEEK_SET);
+    load_edges(graph_file, config.num_nodes, num_edges, edges);
+    fclose(graph_file);
+    string threads = "_t" + to_string(config.num_threads);
+    measure("cc", "par" + threads, num_edges, num_bytes, config.repetitions, []() {},
+        [&]() { parallel_union_find(edges, config.num_nodes, config.num_threads, comp_map); });
+    csr_graph_t csr;
+    measure("cc", "csr" + threads, num_edges, num_bytes, config.repetitions, []() {},
+        [&]() { build_csr(edges, config.num_nodes, config.num_threads, csr); });
+    measure("cc", "afforest" + threads, num_edges, num_bytes, config.repetitions, []() {},
+        [&]() { afforest(csr, config.num_threads, comp_map); });
+}
+
+/**
+ * @brief Prints the usage message of the program
+ *
+ * @param name name of the executable
+ */
+static void print_usage(const char *name) {
+    cerr << "Usage: " << name << " [options]\n"
+        << "Options:\n"
+        << "  -n <num_nodes>    number of nodes of the synthetic graphs (default: 16777216)\n"
+        << "  -m <num_edges>    number of edges of the synthetic graphs (default: 16777216)\n"
+        << "  -x <num_tx>       number of synthetic transactions (default: 1048576)\n"
+        << "  -r <repetitions>  number of timed runs of each kernel (default: 3)\n"
+        << "  -t <num_threads>  number of threads of the parallel kernels (default: number of hardware threads)\n"
+        << "  -k <kernels>      comma-separated kernels to run: parse, sort, dedup, write, read, cc, union_find\n";
+}
+
+int main(int argc, char **argv) {
+    bench_config_t config;
+    config.num_nodes = 1 << 24;
+    config.num_edges = 1 << 24;
+    config.num_tx = 1 << 20;
+    config.repetitions = 3;
+    config.num_threads = default_num_threads();
+    int opt;
+    while ((opt = getopt(argc, argv, "k:m:n:r:t:x:")) != -1) {
+        switch (opt) {
+            case 'k':
+                config.kernels = optarg;
+                break;
+            case 'n':
+                config.num_nodes = atol(optarg);
+                break;
+            case 'm':
+                config.num_edges = atoll(optarg);
+                break;
+            case 'r':
+                config.repetitions = atoi(optarg);
+                break;
+            case 't':
+                config.num_threads = atoi(optarg);
+                break;
+            case 'x':
+                config.num_tx = atoll(optarg);
+                break;
+            default:
+                print_usage(argv[0]);
+                return 1;
+        }
+    }
+    if (config.num_nodes < 1 || config.repetitions < 1 || config.num_threads < 1) {
+        cerr << "Error: the number of nodes, of repetitions and of threads must be positive!\n";
+        return 1;
+    }
+
+    if (!perf_open(&counters)) cerr << "Warning: hardware counters are not available!\n";
+    cout << "kernel\tvariant\tns_per_op\tmops\tmb_per_s\tstddev_pct\tmiss_rate\tmisses_per_op\n";
+    if (selected(config, "parse")) bench_parser(config);
+    if (selected(config, "sort") || selected(config, "dedup")) bench_sort(config);
+    if (selected(config, "write") || selected(config, "read")) bench_graph_file(config);
+    if (selected(config, "cc")) bench_components(config);
+    if (selected(config, "union_find")) bench_union_find(config);
+    perf_close(&counters);
+    return 0;
+}
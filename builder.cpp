@@ -48,145 +48,238 @@
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
-#include <utility>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <vector>
 
+#include "checkpoint.hpp"
+#include "graph_file.hpp"
+#include "progress.hpp"
+#include "report.hpp"
+#include "transactions.hpp"
+
 using namespace std;
 using namespace std::chrono;
 
-/// @brief The edge list contains ordered pairs representing graph edges
-typedef vector<pair<int,int>> edge_list_t;
-
 /**
- * @brief Processes the list of transaction inputs (represented as a semicolon-separated string)
- * 
- * @param inputs string containing all transaction inputs
- * @param max_id maximum address identifier seen while parsing transactions
- * @param edges list of graph edges
- */
-void process_inputs(char *inputs, int *max_id, edge_list_t &edges) {
-    char *ptr = inputs, *save_ptr;
-    // Obtain the first input address.
-    char *input = strtok_r(ptr, ";", &save_ptr);
-    int first_address = atoi(strtok(input, ","));
-    if (first_address >= *max_id) *max_id = first_address;
-    // Iterate trough all remaining inputs.
-    int curr_address;
-    while ((input = strtok_r(NULL, ";", &save_ptr))) {
-        // Extract the current address.
-        curr_address = atoi(strtok(input, ","));
-        // Skip this address if it is equal to the first one.
-        if (curr_address == first_address) continue;
-        // Create the new edge.
-        edges.push_back(minmax(first_address, curr_address));
-        // Update the maximum identifier, if necessary.
-        if (curr_address >= *max_id) *max_id = curr_address;
-    }
-}
-
-/**
- * @brief Processes the list of transaction outputs (represented as a semicolon-separated string)
- * 
- * @param outputs string containing all transaction outputs
- * @param max_id maximum address identifier seen while parsing transactions
- * @param edges list of graph edges 
+ * @brief Prints the usage of the program
+ *
+ * @param program name of the program
  */
-void process_outputs(char *outputs, int *max_id, edge_list_t &edges) {
-    char *ptr, *save_ptr, *output_str, *address_str;
-    int address;
-    for (ptr = outputs; ; ptr = NULL) {
-        if (!(output_str = strtok_r(ptr, ";", &save_ptr))) break;
-        // The first field of the output corresponds to the address.
-        address_str = strtok(output_str, ",");
-        address = atoi(address_str);
-        // Update the maximum identifier, if necessary.
-        if (address >= *max_id) *max_id = address;
-    }
+void print_usage(const char *program) {
+    cerr << "Usage: " << program << " [options] <input_file> <output_file>\n"
+        << "Options:\n"
+        << "  -C <dir>          periodically spill the edges to sorted runs in dir and save a checkpoint\n"
+        << "  -R                resume from the last checkpoint in the directory given with -C\n"
+        << "  -m <run_mb>       size of the edges kept in memory before spilling a run (default: 1024)\n"
+        << "  -i <seconds>      maximum time between two checkpoints (default: 600)\n"
+        << "  -j <report_file>  write a JSON report with the time, throughput and memory of each phase\n"
+        << "  -H                include the hardware counters of each phase in the report\n"
+        << "  -p <seconds>      print the progress of the parsing phase every few seconds (default: 10 with -P)\n"
+        << "  -P <status_file>  write the progress to status_file instead of the standard error\n";
 }
 
-/**
- * @brief Processes a single line of the input file (i.e., a transaction)
- * 
- * @param line_buf buffer containing the line
- * @param max_id maximum address identifier seen while parsing transactions
- * @param edges list of graph edges
- */
-void process_line(char *line_buf, int *max_id, edge_list_t &edges) {
-    char *token = NULL;
-    int token_count = 0;
-    while ((token = strsep(&line_buf, ":"))) {
-        if (token_count == 1) {
-            // Processing inputs
-            if (token[0] != '\0') process_inputs(token, max_id, edges);
-        }
-        if (token_count == 2) {
-            // Processing outputs
-            if (token[0] != '\0') process_outputs(token, max_id, edges);
+int main(int argc, char **argv) {
+    // Parse the options.
+    const char *report_path = NULL;
+    bool use_counters = false;
+    double progress_sec = 0;
+    const char *status_path = NULL;
+    const char *checkpoint_dir = NULL;
+    bool resume = false;
+    size_t run_mb = 1024;
+    double checkpoint_sec = 600;
+    int opt;
+    while ((opt = getopt(argc, argv, "C:Hi:j:m:P:p:R")) != -1) {
+        switch (opt) {
+            case 'C':
+                checkpoint_dir = optarg;
+                break;
+            case 'H':
+                use_counters = true;
+                break;
+            case 'i':
+                checkpoint_sec = atof(optarg);
+                if (checkpoint_sec <= 0) {
+                    cerr << "Error: the checkpoint interval must be positive!\n";
+                    return 1;
+                }
+                break;
+            case 'j':
+                report_path = optarg;
+                break;
+            case 'm':
+                run_mb = atol(optarg);
+                if (run_mb < 1) {
+                    cerr << "Error: the run size must be positive!\n";
+                    return 1;
+                }
+                break;
+            case 'P':
+                status_path = optarg;
+                break;
+            case 'p':
+                progress_sec = atof(optarg);
+                if (progress_sec <= 0) {
+                    cerr << "Error: the progress interval must be positive!\n";
+                    return 1;
+                }
+                break;
+            case 'R':
+                resume = true;
+                break;
+            default:
+                print_usage(argv[0]);
+                return 1;
         }
-        token_count++;
     }
-}
-
-int main(int argc, char **argv) {
     // Check the input arguments.
-    if (argc < 3) {
-        cerr << "Usage: " << argv[0] << " <input_file> <output_file>\n";
+    if (argc - optind < 2) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (resume && !checkpoint_dir) {
+        cerr << "Error: resuming requires a checkpoint directory!\n";
         return 1;
     }
 
     auto start = high_resolution_clock::now();
+    run_report_t report;
+    report_init(&report, "builder");
+    if (use_counters && !report_enable_counters(&report)) {
+        cerr << "Warning: hardware counters are not available!\n";
+    }
 
     // Open the input and output files.
-    FILE *input_file = fopen(argv[1], "r");
+    FILE *input_file = fopen(argv[optind], "r");
     if (!input_file) {
         cerr << "Error: could not open input file!\n";
         return 1;
     }
-    FILE *output_file = fopen(argv[2], "wb");
+    FILE *output_file = fopen(argv[optind+1], "wb");
     if (!output_file) {
         cerr << "Error: could not open output file!\n";
         return 1;
     }
+    FILE *report_file = NULL;
+    if (report_path && !(report_file = fopen(report_path, "w"))) {
+        cerr << "Error: could not open report file!\n";
+        return 1;
+    }
+
+    // Resume from the last checkpoint, if requested, skipping the part of the input already processed.
+    checkpoint_header_t checkpoint;
+    memset(&checkpoint, 0, sizeof(checkpoint));
+    if (resume) {
+        if (!read_checkpoint(checkpoint_dir, &checkpoint)) {
+            cerr << "Warning: no checkpoint found, starting from the beginning!\n";
+            memset(&checkpoint, 0, sizeof(checkpoint));
+        }
+        else if (fseeko(input_file, checkpoint.input_offset, SEEK_SET) != 0) {
+            cerr << "Error: could not seek in the input file!\n";
+            return 1;
+        }
+    }
+    size_t run_edges = (run_mb << 20) / sizeof(pair<int,int>);
+    auto checkpoint_interval = duration<double>(checkpoint_sec);
+    auto last_checkpoint = steady_clock::now();
 
     // Read the input file line by line and build the graph.
+    // If requested, a reporter thread periodically prints the progress and,
+    // with checkpoints, the edges are spilled to a sorted run whenever the
+    // buffer is full or the checkpoint interval has elapsed.
+    phase_begin(&report, "parse");
+    // After a resume, the counters start from the checkpoint, but the rates
+    // only count the transactions processed by this run.
+    progress_counters_t resumed = {checkpoint.input_offset, checkpoint.num_tx, checkpoint.num_edges};
+    progress_counters_t progress = resumed;
+    progress_reporter_t reporter;
+    bool show_progress = (progress_sec > 0 || status_path);
+    if (show_progress) {
+        struct stat input_stat;
+        uint64_t input_size = (fstat(fileno(input_file), &input_stat) == 0 && S_ISREG(input_stat.st_mode)) ?
+            input_stat.st_size : 0;
+        progress_start(&reporter, &progress, &resumed, input_size,
+            (progress_sec > 0) ? progress_sec * 1000 : 10000, status_path);
+    }
     edge_list_t edges;
-    int max_id = 0;
+    int max_id = checkpoint.max_id;
     char *line_buf = NULL;
     size_t line_size = 0;
-    while (getline(&line_buf, &line_size, input_file) > 0) {
+    ssize_t line_length;
+    uint64_t input_bytes = checkpoint.input_offset, num_tx = checkpoint.num_tx;
+    uint64_t resumed_bytes = input_bytes, resumed_tx = num_tx;
+    while ((line_length = getline(&line_buf, &line_size, input_file)) > 0) {
         process_line(line_buf, &max_id, edges);
+        input_bytes += line_length;
+        num_tx++;
+        progress_set(&progress.bytes, input_bytes);
+        progress_set(&progress.records, num_tx);
+        progress_set(&progress.edges, checkpoint.num_edges + edges.size());
+        if (checkpoint_dir && (edges.size() >= run_edges ||
+            ((num_tx % CHECKPOINT_CLOCK_TX) == 0 && steady_clock::now() - last_checkpoint >= checkpoint_interval))) {
+            if (!spill_run(run_path(checkpoint_dir, checkpoint.num_runs), edges)) {
+                cerr << "Error: could not write a run of edges!\n";
+                return 1;
+            }
+            checkpoint.max_id = max_id;
+            checkpoint.input_offset = input_bytes;
+            checkpoint.num_tx = num_tx;
+            checkpoint.num_runs++;
+            checkpoint.num_edges += edges.size();
+            if (!write_checkpoint(checkpoint_dir, &checkpoint)) {
+                cerr << "Error: could not write the checkpoint!\n";
+                return 1;
+            }
+            edges.clear();
+            last_checkpoint = steady_clock::now();
+        }
     }
+    free(line_buf);
+    if (show_progress) progress_stop(&reporter);
+    phase_end(&report, input_bytes - resumed_bytes, num_tx - resumed_tx);
 
     // Sort the list of edges.
+    phase_begin(&report, "sort");
     sort(edges.begin(), edges.end());
+    phase_end(&report, edges.size() * sizeof(edges[0]), edges.size());
 
-    // First, write the list of edges to the graph file.
-    int buf[2];
+    // Remove duplicate edges.
+    phase_begin(&report, "dedup");
+    size_t num_sorted = edges.size();
+    edges.erase(unique(edges.begin(), edges.end()), edges.end());
+    phase_end(&report, num_sorted * sizeof(edges[0]), num_sorted);
+
+    // Write the graph file, merging the edges in memory with the spilled runs, if any.
+    phase_begin(&report, "write");
     int num_nodes = max_id + 1;
-    int num_edges = 0;
-    fseek(output_file, 8, SEEK_SET);
-    for (int i = 0; i < edges.size(); i++) {
-        if (i == 0 || edges[i] != edges[i-1]) {
-            // Skip duplicates.
-            buf[0] = __builtin_bswap32(edges[i].first);
-            buf[1] = __builtin_bswap32(edges[i].second);
-            fwrite(buf, sizeof(int), 2, output_file);
-            num_edges++;
-        }
+    int num_edges = edges.size();
+    bool written;
+    if (checkpoint.num_runs == 0) written = write_graph(output_file, num_nodes, edges);
+    else {
+        uint64_t num_merged;
+        written = merge_runs(checkpoint_dir, checkpoint.num_runs, edges, output_file, num_nodes, &num_merged);
+        num_edges = num_merged;
     }
-    // Then, write the number of nodes and edges at the beginning of the file.
-    fseek(output_file, 0, SEEK_SET);
-    buf[0] = __builtin_bswap32(num_nodes);
-    buf[1] = __builtin_bswap32(num_edges);
-    fwrite(buf, sizeof(int), 2, output_file);
 
     // Close the input and output files.
     fclose(input_file);
-    fclose(output_file);
+    if (fclose(output_file) != 0 || !written) {
+        cerr << "Error: could not write the output file!\n";
+        return 1;
+    }
+    phase_end(&report, 8 + (uint64_t) num_edges * 8, num_edges);
+    if (checkpoint_dir) remove_checkpoint(checkpoint_dir, checkpoint.num_runs);
 
     auto end = high_resolution_clock::now();
     auto duration = duration_cast<nanoseconds>(end - start);
 
+    // Write the report, if requested.
+    if (report_file) {
+        write_report(report_file, &report);
+        fclose(report_file);
+    }
+
     // Print statistics.
     cout << num_nodes << '\t' << num_edges << '\t' << duration.count() << '\n';
     return 0;
@@ -0,0 +1,151 @@
+/**
+ * @file checkpoint.cpp
+ * @author Matteo Loporchio
+ * @brief Checkpoints of the builder, with the edges spilled to sorted runs
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#include "checkpoint.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <queue>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+
+/// @brief Buffered reader of a sorted run of edges
+typedef struct {
+    FILE *file;                         ///< the run file (NULL for the edges in memory)
+    const pair<int,int> *edges;         ///< current block of edges
+    size_t pos, len;                    ///< position of the next edge and length of the block
+    vector<pair<int,int>> buf;          ///< buffer of the block read from the file
+} run_reader_t;
+
+/**
+ * @brief Moves a run reader to its next edge, reading the next block if needed
+ *
+ * @param reader the reader
+ * @return true if there is a next edge, false at the end of the run
+ */
+static bool run_next(run_reader_t *reader) {
+    if (++reader->pos < reader->len) return true;
+    if (!reader->file) return false;
+    reader->len = fread(reader->buf.data(), sizeof(pair<int,int>), reader->buf.size(), reader->file);
+    reader->edges = reader->buf.data();
+    reader->pos = 0;
+    return reader->len > 0;
+}
+
+/**
+ * @brief Path of the checkpoint file of a directory
+ *
+ * @param dir the checkpoint directory
+ */
+static string checkpoint_path(const string &dir) {
+    return dir + "/checkpoint";
+}
+
+string run_path(const string &dir, uint64_t run) {
+    char name[32];
+    snprintf(name, sizeof(name), "/run_%06llu.bin", (unsigned long long) run);
+    return dir + name;
+}
+
+bool read_checkpoint(const string &dir, checkpoint_header_t *checkpoint) {
+    FILE *checkpoint_file = fopen(checkpoint_path(dir).c_str(), "rb");
+    if (!checkpoint_file) return false;
+    bool valid = fread(checkpoint, sizeof(*checkpoint), 1, checkpoint_file) == 1 &&
+        memcmp(checkpoint->magic, CHECKPOINT_MAGIC, sizeof(checkpoint->magic)) == 0 &&
+        checkpoint->version == CHECKPOINT_VERSION && checkpoint->max_id >= 0;
+    fclose(checkpoint_file);
+    return valid;
+}
+
+bool write_checkpoint(const string &dir, checkpoint_header_t *checkpoint) {
+    memcpy(checkpoint->magic, CHECKPOINT_MAGIC, sizeof(checkpoint->magic));
+    checkpoint->version = CHECKPOINT_VERSION;
+    string path = checkpoint_path(dir), tmp_path = path + ".tmp";
+    FILE *checkpoint_file = fopen(tmp_path.c_str(), "wb");
+    if (!checkpoint_file) return false;
+    bool written = fwrite(checkpoint, sizeof(*checkpoint), 1, checkpoint_file) == 1 &&
+        fflush(checkpoint_file) == 0 && fsync(fileno(checkpoint_file)) == 0;
+    if (fclose(checkpoint_file) != 0 || !written) return false;
+    return rename(tmp_path.c_str(), path.c_str()) == 0;
+}
+
+bool spill_run(const string &path, edge_list_t &edges) {
+    sort(edges.begin(), edges.end());
+    edges.erase(unique(edges.begin(), edges.end()), edges.end());
+    FILE *run_file = fopen(path.c_str(), "wb");
+    if (!run_file) return false;
+    bool written = fwrite(edges.data(), sizeof(edges[0]), edges.size(), run_file) == edges.size() &&
+        fflush(run_file) == 0 && fsync(fileno(run_file)) == 0;
+    return fclose(run_file) == 0 && written;
+}
+
+bool merge_runs(const string &dir, uint64_t num_runs, const edge_list_t &edges,
+    FILE *output_file, int num_nodes, uint64_t *num_edges) {
+    // Open the runs, plus one reader for the edges in memory.
+    vector<run_reader_t> readers(num_runs + 1);
+    bool valid = true;
+    for (uint64_t r = 0; r < num_runs; r++) {
+        readers[r].file = fopen(run_path(dir, r).c_str(), "rb");
+        if (!readers[r].file) {
+            valid = false;
+            break;
+        }
+        readers[r].buf.resize(MERGE_BUFFER_EDGES);
+        readers[r].pos = readers[r].len = 0;
+    }
+    readers[num_runs].file = NULL;
+    readers[num_runs].edges = edges.data();
+    readers[num_runs].pos = (size_t) -1;
+    readers[num_runs].len = edges.size();
+    // The header is rewritten with the number of edges at the end.
+    valid = valid && write_graph_header(output_file, num_nodes, 0);
+    // Repeatedly take the smallest edge among the heads of the runs, skipping duplicates.
+    typedef pair<pair<int,int>, size_t> head_t;
+    priority_queue<head_t, vector<head_t>, greater<head_t>> heads;
+    for (size_t r = 0; valid && r < readers.size(); r++) {
+        if (run_next(&readers[r])) heads.push(head_t(readers[r].edges[readers[r].pos], r));
+    }
+    vector<pair<int,int>> out;
+    out.reserve(MERGE_BUFFER_EDGES);
+    pair<int,int> last;
+    uint64_t count = 0;
+    while (valid && !heads.empty()) {
+        head_t head = heads.top();
+        heads.pop();
+        if (count == 0 || head.first != last) {
+            last = head.first;
+            out.push_back(last);
+            count++;
+            if (out.size() == MERGE_BUFFER_EDGES) {
+                valid = write_graph_edges(output_file, out.data(), out.size());
+                out.clear();
+            }
+        }
+        run_reader_t *reader = &readers[head.second];
+        if (run_next(reader)) heads.push(head_t(reader->edges[reader->pos], head.second));
+    }
+    valid = valid && write_graph_edges(output_file, out.data(), out.size());
+    for (uint64_t r = 0; r < num_runs; r++) {
+        if (readers[r].file) fclose(readers[r].file);
+    }
+    // Write the final header.
+    valid = valid && fseeko(output_file, 0, SEEK_SET) == 0 &&
+        write_graph_header(output_file, num_nodes, (int) count);
+    *num_edges = count;
+    return valid;
+}
+
+void remove_checkpoint(const string &dir, uint64_t num_runs) {
+    unlink(checkpoint_path(dir).c_str());
+    for (uint64_t r = 0; r < num_runs; r++) unlink(run_path(dir, r).c_str());
+}
@@ -0,0 +1,121 @@
+/**
+ * @file checkpoint.hpp
+ * @author Matteo Loporchio
+ * @brief Checkpoints of the builder, with the edges spilled to sorted runs
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * With checkpoints enabled, the builder periodically sorts and deduplicates
+ * the edges accumulated so far and writes them to a run file in the checkpoint
+ * directory (run_000000.bin, run_000001.bin, ...), as an array of pairs of
+ * 32-bit integers in native byte order. After each run is safely on disk,
+ * a checkpoint file (see checkpoint_header_t) records the number of runs,
+ * the number of bytes of the input file and of transactions processed and
+ * the maximum address identifier. The checkpoint is written to a temporary
+ * file and then renamed, so it always describes a consistent state:
+ * a resumed run seeks past the processed part of the input and continues
+ * from there, overwriting any run written after the last checkpoint.
+ *
+ * At the end, the runs and the edges still in memory are merged,
+ * removing the duplicates, directly into the graph file. The result is
+ * identical to the graph built without checkpoints.
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "graph_file.hpp"
+
+/// @brief Magic string at the beginning of a checkpoint file
+#define CHECKPOINT_MAGIC "BLDCKPT\0"
+
+/// @brief Current version of the checkpoint format
+#define CHECKPOINT_VERSION 1
+
+/// @brief Number of transactions between two checks of the checkpoint interval
+#define CHECKPOINT_CLOCK_TX 4096
+
+/// @brief Number of edges buffered for each run while merging
+#define MERGE_BUFFER_EDGES (1 << 16)
+
+/// @brief Header of a checkpoint file
+typedef struct {
+    char magic[8];              ///< CHECKPOINT_MAGIC
+    uint32_t version;           ///< CHECKPOINT_VERSION
+    int32_t max_id;             ///< maximum address identifier seen so far
+    uint64_t input_offset;      ///< number of bytes of the input file processed so far
+    uint64_t num_tx;            ///< number of transactions processed so far
+    uint64_t num_runs;          ///< number of complete runs
+    uint64_t num_edges;         ///< total number of edges in the runs
+} checkpoint_header_t;
+
+/**
+ * @brief Returns the path of a run file
+ *
+ * @param dir the checkpoint directory
+ * @param run index of the run
+ */
+std::string run_path(const std::string &dir, uint64_t run);
+
+/**
+ * @brief Reads the checkpoint file of a directory
+ *
+ * @param dir the checkpoint directory
+ * @param checkpoint receives the checkpoint
+ * @return true on success, false if there is no valid checkpoint
+ */
+bool read_checkpoint(const std::string &dir, checkpoint_header_t *checkpoint);
+
+/**
+ * @brief Writes the checkpoint file of a directory, atomically replacing the previous one
+ *
+ * @param dir the checkpoint directory
+ * @param checkpoint the checkpoint (the magic string and version are filled in)
+ * @return true on success, false on error
+ */
+bool write_checkpoint(const std::string &dir, checkpoint_header_t *checkpoint);
+
+/**
+ * @brief Sorts and deduplicates a list of edges and writes it to a run file
+ *
+ * The file is flushed to disk before returning, so that a checkpoint
+ * can then refer to it.
+ *
+ * @param path path of the run file
+ * @param edges the list of edges, sorted and deduplicated in place
+ * @return true on success, false on error
+ */
+bool spill_run(const std::string &path, edge_list_t &edges);
+
+/**
+ * @brief Merges the runs of a directory and a list of edges into a graph file
+ *
+ * The output file must be seekable, since the number of edges is only
+ * known at the end of the merge and is then written into the header.
+ *
+ * @param dir the checkpoint directory
+ * @param num_runs number of runs
+ * @param edges list of edges still in memory, sorted and without duplicates
+ * @param output_file pointer to the (already opened) graph file
+ * @param num_nodes number of nodes of the graph
+ * @param num_edges receives the number of distinct edges written
+ * @return true on success, false on error
+ */
+bool merge_runs(const std::string &dir, uint64_t num_runs, const edge_list_t &edges,
+    FILE *output_file, int num_nodes, uint64_t *num_edges);
+
+/**
+ * @brief Removes the checkpoint file and the runs of a directory
+ *
+ * @param dir the checkpoint directory
+ * @param num_runs number of runs
+ */
+void remove_checkpoint(const std::string &dir, uint64_t num_runs);
+
+#endif
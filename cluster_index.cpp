@@ -0,0 +1,100 @@
+/**
+ * @file cluster_index.cpp
+ * @author Matteo Loporchio
+ * @brief Inverted index from clusters (i.e., connected components) to their members
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#include "cluster_index.hpp"
+#include "output.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+void build_cluster_index(const comp_map_t &comp_map, const vector<uint32_t> &sizes,
+    int num_threads, vector<uint32_t> &offsets, vector<uint32_t> &members) {
+    size_t num_labels = sizes.size();
+    offsets.resize(num_labels + 1);
+    members.resize(comp_map.size());
+    // Compute the offsets with a two-pass parallel prefix sum.
+    vector<uint32_t> partial(num_threads + 1, 0);
+    parallel_for(num_threads, num_labels, [&](int t, size_t begin, size_t end) {
+        uint32_t sum = 0;
+        for (size_t c = begin; c < end; c++) sum += sizes[c];
+        partial[t + 1] = sum;
+    });
+    for (int t = 0; t < num_threads; t++) partial[t + 1] += partial[t];
+    parallel_for(num_threads, num_labels, [&](int t, size_t begin, size_t end) {
+        uint32_t sum = partial[t];
+        for (size_t c = begin; c < end; c++) {
+            offsets[c] = sum;
+            sum += sizes[c];
+        }
+    });
+    offsets[num_labels] = comp_map.size();
+    // Sort the nodes by component with a least-significant-digit radix sort,
+    // so that the scratch space does not depend on the number of components.
+    // Each pass is a stable counting sort: the threads count the digits in
+    // their slices (the same in both loops, since parallel_for splits the range
+    // deterministically) and scatter their nodes after those of the previous
+    // slices. The nodes start in increasing order, so the lists stay sorted.
+    int label_bits = 1;
+    while (label_bits < 32 && ((size_t) 1 << label_bits) < num_labels) label_bits++;
+    int num_passes = (label_bits + CLUSTER_INDEX_RADIX_BITS - 1) / CLUSTER_INDEX_RADIX_BITS;
+    int digit_bits = (label_bits + num_passes - 1) / num_passes;
+    size_t num_buckets = (size_t) 1 << digit_bits, num_nodes = comp_map.size();
+    uint32_t mask = num_buckets - 1;
+    vector<uint32_t> tmp((num_passes > 1) ? num_nodes : 0);
+    vector<uint32_t> cursor((size_t) num_threads * num_buckets);
+    const uint32_t *map = comp_map.data();
+    for (int p = 0; p < num_passes; p++) {
+        // The last pass writes the members, the previous ones alternate with tmp.
+        // The first pass reads the nodes in increasing order.
+        uint32_t *dst = ((num_passes - 1 - p) % 2 == 0) ? members.data() : tmp.data();
+        const uint32_t *src = (p == 0) ? NULL : ((dst == members.data()) ? tmp.data() : members.data());
+        int shift = p * digit_bits;
+        fill(cursor.begin(), cursor.end(), 0);
+        parallel_for(num_threads, num_nodes, [&](int t, size_t begin, size_t end) {
+            uint32_t *count = cursor.data() + (size_t) t * num_buckets;
+            for (size_t i = begin; i < end; i++) {
+                uint32_t v = src ? src[i] : i;
+                count[(map[v] >> shift) & mask]++;
+            }
+        });
+        // Turn the counts into the position of the first node of each slice
+        // in each bucket, taking the slices in thread order.
+        uint32_t pos = 0;
+        for (size_t b = 0; b < num_buckets; b++) {
+            for (int t = 0; t < num_threads; t++) {
+                uint32_t count = cursor[(size_t) t * num_buckets + b];
+                cursor[(size_t) t * num_buckets + b] = pos;
+                pos += count;
+            }
+        }
+        parallel_for(num_threads, num_nodes, [&](int t, size_t begin, size_t end) {
+            uint32_t *next = cursor.data() + (size_t) t * num_buckets;
+            for (size_t i = begin; i < end; i++) {
+                uint32_t v = src ? src[i] : i;
+                dst[next[(map[v] >> shift) & mask]++] = v;
+            }
+        });
+    }
+}
+
+bool write_cluster_index(int fd, const vector<uint32_t> &offsets, const vector<uint32_t> &members) {
+    cluster_index_header_t header;
+    memcpy(header.magic, CLUSTER_INDEX_MAGIC, sizeof(header.magic));
+    header.version = CLUSTER_INDEX_VERSION;
+    header.reserved = 0;
+    header.num_components = offsets.size() - 1;
+    header.num_nodes = members.size();
+    return write_all(fd, (const char *) &header, sizeof(header))
+        && write_all(fd, (const char *) offsets.data(), offsets.size() * sizeof(uint32_t))
+        && write_all(fd, (const char *) members.data(), members.size() * sizeof(uint32_t));
+}
@@ -0,0 +1,76 @@
+/**
+ * @file cluster_index.hpp
+ * @author Matteo Loporchio
+ * @brief Inverted index from clusters (i.e., connected components) to their members
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * The index is stored in CSR format: the members of component c are
+ * members[offsets[c]], ..., members[offsets[c+1]-1], in increasing order.
+ *
+ * An index file contains a 32-byte header (see cluster_index_header_t),
+ * followed by the num_components + 1 offsets and by the num_nodes members,
+ * all as 32-bit unsigned integers in native byte order. When the file is
+ * mapped in memory with mmap, the members of a component can be listed in
+ * time proportional to its size.
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#ifndef CLUSTER_INDEX_HPP
+#define CLUSTER_INDEX_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "components.hpp"
+
+/// @brief Magic string at the beginning of a cluster index file
+#define CLUSTER_INDEX_MAGIC "CCINDEX\0"
+
+/// @brief Maximum number of bits of the digits of the radix sort building the index
+#define CLUSTER_INDEX_RADIX_BITS 16
+
+/// @brief Current version of the cluster index format
+#define CLUSTER_INDEX_VERSION 1
+
+/// @brief Header of a cluster index file
+typedef struct {
+    char magic[8];              ///< CLUSTER_INDEX_MAGIC
+    uint32_t version;           ///< CLUSTER_INDEX_VERSION
+    uint32_t reserved;          ///< always zero
+    uint64_t num_components;    ///< number of component identifiers (i.e., number of offsets minus one)
+    uint64_t num_nodes;         ///< number of members
+} cluster_index_header_t;
+
+/**
+ * @brief Builds the inverted index of a component map by radix sort
+ *
+ * Offsets are the prefix sums of the component sizes. The nodes are then
+ * sorted by component with a parallel, stable radix sort on digits of up to
+ * CLUSTER_INDEX_RADIX_BITS bits (one pass for up to 2^16 components, two
+ * passes otherwise), so the lists come out sorted without atomics. Besides the
+ * index, the sort needs one scratch array of 4 bytes per node (only with more
+ * than one pass) and num_threads counters per bucket.
+ *
+ * @param comp_map the component map
+ * @param sizes the size of each component (see count_component_sizes())
+ * @param num_threads number of threads
+ * @param offsets receives the sizes.size() + 1 offsets
+ * @param members receives the members of each component
+ */
+void build_cluster_index(const comp_map_t &comp_map, const std::vector<uint32_t> &sizes,
+    int num_threads, std::vector<uint32_t> &offsets, std::vector<uint32_t> &members);
+
+/**
+ * @brief Writes a cluster index file
+ *
+ * @param fd descriptor of the (already opened) output file
+ * @param offsets the offsets of the index
+ * @param members the members of the index
+ * @return true on success, false on error
+ */
+bool write_cluster_index(int fd, const std::vector<uint32_t> &offsets,
+    const std::vector<uint32_t> &members);
+
+#endif
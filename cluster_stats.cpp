@@ -0,0 +1,94 @@
+/**
+ * @file cluster_stats.cpp
+ * @author Matteo Loporchio
+ * @brief Statistics on the sizes of the clusters (i.e., connected components)
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#include "cluster_stats.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+
+using namespace std;
+
+/// @brief Number of entries of the per-thread cache of component counters
+#define SIZE_CACHE_ENTRIES 64
+
+void count_component_sizes(const comp_map_t &comp_map, uint32_t num_labels, int num_threads,
+    vector<uint32_t> &sizes) {
+    sizes.assign(num_labels, 0);
+    const uint32_t *map = comp_map.data();
+    uint32_t *size_ptr = sizes.data();
+    parallel_for(num_threads, comp_map.size(), [&](int t, size_t begin, size_t end) {
+        uint32_t keys[SIZE_CACHE_ENTRIES], counts[SIZE_CACHE_ENTRIES];
+        for (int k = 0; k < SIZE_CACHE_ENTRIES; k++) counts[k] = 0;
+        for (size_t i = begin; i < end; i++) {
+            uint32_t c = map[i], k = c % SIZE_CACHE_ENTRIES;
+            if (counts[k] > 0 && keys[k] != c) {
+                __atomic_fetch_add(&size_ptr[keys[k]], counts[k], __ATOMIC_RELAXED);
+                counts[k] = 0;
+            }
+            keys[k] = c;
+            counts[k]++;
+        }
+        for (int k = 0; k < SIZE_CACHE_ENTRIES; k++) {
+            if (counts[k] > 0) __atomic_fetch_add(&size_ptr[keys[k]], counts[k], __ATOMIC_RELAXED);
+        }
+    });
+}
+
+void write_size_report(FILE *output_file, const vector<uint32_t> &sizes, int top_k) {
+    uint64_t num_nodes = 0, num_cc = 0, singletons = 0;
+    vector<uint64_t> histogram;
+    // Keep the top_k largest components in a min-heap ordered by (size, -identifier).
+    typedef pair<uint32_t, int64_t> entry_t;
+    priority_queue<entry_t, vector<entry_t>, greater<entry_t>> top;
+    for (size_t c = 0; c < sizes.size(); c++) {
+        uint32_t size = sizes[c];
+        if (size == 0) continue;
+        num_nodes += size;
+        num_cc++;
+        if (size == 1) singletons++;
+        int bin = 31 - __builtin_clz(size);
+        if ((int) histogram.size() <= bin) histogram.resize(bin + 1, 0);
+        histogram[bin]++;
+        if (top_k <= 0) continue;
+        entry_t e(size, -(int64_t) c);
+        if ((int) top.size() < top_k) top.push(e);
+        else if (top.top() < e) {
+            top.pop();
+            top.push(e);
+        }
+    }
+    vector<entry_t> largest;
+    while (!top.empty()) {
+        largest.push_back(top.top());
+        top.pop();
+    }
+    reverse(largest.begin(), largest.end());
+
+    fprintf(output_file, "{\n");
+    fprintf(output_file, "  \"num_nodes\": %llu,\n", (unsigned long long) num_nodes);
+    fprintf(output_file, "  \"num_components\": %llu,\n", (unsigned long long) num_cc);
+    fprintf(output_file, "  \"singletons\": %llu,\n", (unsigned long long) singletons);
+    fprintf(output_file, "  \"histogram\": [");
+    for (size_t b = 0; b < histogram.size(); b++) {
+        fprintf(output_file, "%s\n    {\"min_size\": %llu, \"max_size\": %llu, \"count\": %llu}",
+            (b == 0) ? "" : ",", 1ULL << b, (2ULL << b) - 1, (unsigned long long) histogram[b]);
+    }
+    fprintf(output_file, "%s],\n", histogram.empty() ? "" : "\n  ");
+    fprintf(output_file, "  \"top_components\": [");
+    for (size_t i = 0; i < largest.size(); i++) {
+        fprintf(output_file, "%s\n    {\"comp_id\": %lld, \"size\": %u}",
+            (i == 0) ? "" : ",", (long long) -largest[i].second, largest[i].first);
+    }
+    fprintf(output_file, "%s]\n", largest.empty() ? "" : "\n  ");
+    fprintf(output_file, "}\n");
+}
@@ -0,0 +1,49 @@
+/**
+ * @file cluster_stats.hpp
+ * @author Matteo Loporchio
+ * @brief Statistics on the sizes of the clusters (i.e., connected components)
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#ifndef CLUSTER_STATS_HPP
+#define CLUSTER_STATS_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "components.hpp"
+
+/**
+ * @brief Counts the number of nodes of each component
+ *
+ * The nodes are counted in parallel with atomic increments. To avoid
+ * contention on the counters of the largest components, each thread
+ * accumulates the counts in a small direct-mapped cache first.
+ *
+ * @param comp_map the component map
+ * @param num_labels upper bound on the component identifiers
+ * @param num_threads number of threads
+ * @param sizes receives the size of each component (zero for unused identifiers)
+ */
+void count_component_sizes(const comp_map_t &comp_map, uint32_t num_labels, int num_threads,
+    std::vector<uint32_t> &sizes);
+
+/**
+ * @brief Writes a JSON report on the sizes of the components
+ *
+ * The report contains the number of nodes and of components, the number of
+ * singletons, a histogram of the sizes with logarithmic bins (bin b counts the
+ * components whose size is between 2^b and 2^(b+1) - 1) and the top_k largest
+ * components with their sizes (ties are broken by identifier).
+ *
+ * @param output_file pointer to the (already opened) output file
+ * @param sizes the size of each component
+ * @param top_k number of largest components to report
+ */
+void write_size_report(FILE *output_file, const std::vector<uint32_t> &sizes, int top_k);
+
+#endif
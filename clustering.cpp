@@ -11,106 +11,555 @@
  * Each line contains the node identifier and the identifier of its 
  * component, separated by a comma.
  * 
+ * The components can be computed either with igraph (the default)
+ * or with one of the native union-find engines selected by the -e option.
+ * The sequential engine streams the edges from the input file and only keeps
+ * one 32-bit integer per node in memory (with -b, it interleaves the finds
+ * of several edges and prefetches their parents), while the parallel one loads
+ * the edges and processes them with -t threads. The Afforest engine
+ * converts the graph to CSR format and skips most of the edges
+ * of the largest component. Finally, the semi-external engine keeps
+ * only the union-find forest in memory and streams the edges from disk
+ * through a buffer of -m megabytes.
+ * 
+ * By default, the component identifiers are those assigned by the engine.
+ * With -c, they are made canonical, so that the outputs of different
+ * engines and thread counts can be compared byte by byte.
+ * 
+ * With -s, only the nodes of the components larger than a given size
+ * are written, e.g., -s 1 skips all singletons.
+ * The sizes of the components can be summarized in a JSON report
+ * (histogram, singletons and largest components) with -S, and an
+ * inverted index listing the members of each component can be written with -I.
+ * 
+ * The output file can also be written as a binary component map
+ * (see comp_map_file.hpp), which can be mapped in memory by other programs,
+ * or as an Arrow IPC or Parquet file if the corresponding libraries are available.
+ * 
+ * With -D, the components are compared with those of a previous binary
+ * component map, and only the changes are written: the nodes whose component
+ * changed or that are new (to the file given with -d) and the components
+ * absorbed by merges (to the file given with -M). See comp_map_delta.hpp.
+ * 
  * @copyright Copyright (c) 2023 Matteo Loporchio
  */
 
+#include <algorithm>
 #include <chrono>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
 #include <iostream>
-#include <igraph.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "arrow_output.hpp"
+#include "cluster_index.hpp"
+#include "cluster_stats.hpp"
+#include "comp_map_delta.hpp"
+#include "comp_map_file.hpp"
+#include "components.hpp"
+#include "graph_file.hpp"
+#include "igraph_engine.hpp"
+#include "output.hpp"
+#include "parallel.hpp"
+#include "report.hpp"
 
 using namespace std;
 using namespace std::chrono;
 
+/// @brief Engines available for computing the connected components
+enum cc_engine_t {
+    ENGINE_IGRAPH,      ///< igraph_connected_components (reference)
+    ENGINE_UF,          ///< sequential union-find on the streamed edges
+    ENGINE_PAR,         ///< concurrent union-find on the in-memory edge array
+    ENGINE_AFFOREST,    ///< Afforest on the CSR representation of the graph
+    ENGINE_EXTERNAL     ///< concurrent union-find on edges streamed from disk
+};
+
+/// @brief Formats of the output file
+enum output_format_t {
+    FORMAT_CSV,         ///< one "node_id,comp_id" line per node
+    FORMAT_BIN,         ///< binary component map (see comp_map_file.hpp)
+    FORMAT_ARROW,       ///< Arrow IPC file
+    FORMAT_PARQUET      ///< Parquet file
+};
+
+/// @brief Canonical numberings of the components
+enum canonical_labels_t {
+    LABELS_ENGINE,      ///< keep the numbering produced by the engine
+    LABELS_MIN,         ///< each component is identified by its smallest node
+    LABELS_RANK         ///< components are numbered in order of their smallest node
+};
+
+/**
+ * @brief Prints the usage message of the program
+ * 
+ * @param name name of the executable
+ */
+void print_usage(const char *name) {
+    cerr << "Usage: " << name << " [options] <input_file> <output_file> [<num_nodes>]\n"
+        << "Options:\n"
+        << "  -e <engine>       igraph (default), uf, par, afforest or ext\n"
+        << "  -t <num_threads>  number of threads (default: number of hardware threads)\n"
+        << "  -m <buffer_mb>    edge buffer size of the ext engine in megabytes (default: 256)\n"
+        << "  -b <batch_size>   number of interleaved finds of the uf engine (default: 16)\n"
+        << "  -f <format>       format of the output file: csv (default), bin, arrow or parquet\n"
+        << "  -s <min_size>     only write the nodes of components with more than min_size nodes\n"
+        << "  -R <batch_rows>   number of rows of each Arrow record batch or Parquet row group\n"
+        << "  -B <map_file>     also write the binary component map to map_file\n"
+        << "  -w <width>        size in bytes of the binary component map entries: 4 (default) or 8\n"
+        << "  -c <labels>       canonical component identifiers: min (smallest node) or rank\n"
+        << "  -S <stats_file>   write a JSON report on the component sizes to stats_file\n"
+        << "  -k <top_k>        number of largest components in the report (default: 10)\n"
+        << "  -I <index_file>   write the inverted index from components to nodes to index_file\n"
+        << "  -D <prev_map>     compare the components with those of a previous binary component map\n"
+        << "  -d <delta_file>   write the nodes whose component changed, or that are new, to delta_file (with -D)\n"
+        << "  -M <merge_file>   write the previous components merged into other ones to merge_file (with -D)\n"
+        << "  -j <report_file>  write a JSON report with the time, throughput and memory of each phase to report_file\n"
+        << "  -H                include the hardware counters of each phase in the report\n";
+}
+
+/**
+ * @brief Opens a file for writing, truncating it
+ * 
+ * @param path path of the file
+ * @return the file descriptor, or -1 on error
+ */
+int open_output(const char *path) {
+    return open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+}
+
 /**
- * @brief Reads the auxiliary graph from a binary file
+ * @brief Returns the size of an open file, or 0 if it is not a regular file
  * 
- * @param graph igraph data structure where the graph will be stored
- * @param input_file pointer to the (already opened) binary file
- * @param forced_num_nodes defines the number of nodes for the input graph. If zero, the number of nodes will be deduced from the input file.
+ * @param fd the file descriptor
  */
-void read_graph_binary(igraph_t *graph, FILE *input_file, int forced_num_nodes) {
-    // Read the number of nodes and edges from the binary file.
-    int buf[2];
-    int num_read = fread(buf, sizeof(int), 2, input_file);
-    int num_nodes = ((forced_num_nodes == 0) ? __builtin_bswap32(buf[0]) : forced_num_nodes);
-    int num_edges = __builtin_bswap32(buf[1]);
-    // Initialize the graph.
-    igraph_empty(graph, (igraph_integer_t) num_nodes, IGRAPH_UNDIRECTED);
-    // Read edges from the input file and add them to the graph.
-    igraph_vector_int_t edges;
-    igraph_vector_int_init(&edges, 2 * num_edges);
-    igraph_integer_t i = 0;
-    while ((num_read = fread(buf, sizeof(int), 2, input_file)) > 0) {
-        VECTOR(edges)[i] = (igraph_integer_t) (__builtin_bswap32(buf[0]));
-        VECTOR(edges)[i+1] = (igraph_integer_t) (__builtin_bswap32(buf[1]));
-        i += 2;
-    }
-    igraph_add_edges(graph, &edges, NULL);
-    igraph_vector_int_destroy(&edges);
+uint64_t file_size(int fd) {
+    struct stat st;
+    return (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) ? st.st_size : 0;
 }
 
 int main(int argc, char **argv) {
-    if (argc < 3) {
-        cerr << "Usage: " << argv[0] << " <input_file> <output_file> [<num_nodes>]\n";
+    cc_engine_t engine = ENGINE_IGRAPH;
+    int num_threads = default_num_threads();
+    long buffer_mb = 256;
+    int batch_size = 16;
+    output_format_t format = FORMAT_CSV;
+    const char *map_path = NULL;
+    uint32_t map_width = sizeof(uint32_t);
+    canonical_labels_t labels = LABELS_ENGINE;
+    const char *stats_path = NULL;
+    int top_k = 10;
+    const char *index_path = NULL;
+    const char *prev_map_path = NULL;
+    const char *delta_path = NULL;
+    const char *merge_path = NULL;
+    size_t batch_rows = ARROW_BATCH_ROWS;
+    long min_size = 0;
+    const char *report_path = NULL;
+    bool use_counters = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "B:b:c:D:d:e:f:HI:j:k:M:m:R:S:s:t:w:")) != -1) {
+        switch (opt) {
+            case 'B':
+                map_path = optarg;
+                break;
+            case 'b':
+                batch_size = atoi(optarg);
+                if (batch_size < 0) {
+                    cerr << "Error: the batch size must be non-negative!\n";
+                    return 1;
+                }
+                break;
+            case 'c':
+                if (!strcmp(optarg, "min")) labels = LABELS_MIN;
+                else if (!strcmp(optarg, "rank")) labels = LABELS_RANK;
+                else {
+                    cerr << "Error: unknown labeling " << optarg << "!\n";
+                    return 1;
+                }
+                break;
+            case 'D':
+                prev_map_path = optarg;
+                break;
+            case 'd':
+                delta_path = optarg;
+                break;
+            case 'e':
+                if (!strcmp(optarg, "igraph")) engine = ENGINE_IGRAPH;
+                else if (!strcmp(optarg, "uf")) engine = ENGINE_UF;
+                else if (!strcmp(optarg, "par")) engine = ENGINE_PAR;
+                else if (!strcmp(optarg, "afforest")) engine = ENGINE_AFFOREST;
+                else if (!strcmp(optarg, "ext")) engine = ENGINE_EXTERNAL;
+                else {
+                    cerr << "Error: unknown engine " << optarg << "!\n";
+                    return 1;
+                }
+                break;
+            case 'f':
+                if (!strcmp(optarg, "csv")) format = FORMAT_CSV;
+                else if (!strcmp(optarg, "bin")) format = FORMAT_BIN;
+                else if (!strcmp(optarg, "arrow") && arrow_supported()) format = FORMAT_ARROW;
+                else if (!strcmp(optarg, "parquet") && parquet_supported()) format = FORMAT_PARQUET;
+                else {
+                    cerr << "Error: unknown or unsupported output format " << optarg << "!\n";
+                    return 1;
+                }
+                break;
+            case 'I':
+                index_path = optarg;
+                break;
+            case 'H':
+                use_counters = true;
+                break;
+            case 'j':
+                report_path = optarg;
+                break;
+            case 'k':
+                top_k = atoi(optarg);
+                break;
+            case 'M':
+                merge_path = optarg;
+                break;
+            case 'm':
+                buffer_mb = atol(optarg);
+                if (buffer_mb < 1) {
+                    cerr << "Error: the buffer size must be positive!\n";
+                    return 1;
+                }
+                break;
+            case 'R':
+                batch_rows = atol(optarg);
+                if (batch_rows < 1) {
+                    cerr << "Error: the number of rows per batch must be positive!\n";
+                    return 1;
+                }
+                break;
+            case 'S':
+                stats_path = optarg;
+                break;
+            case 's':
+                min_size = atol(optarg);
+                if (min_size < 0 || min_size > UINT32_MAX) {
+                    cerr << "Error: the minimum component size must be between 0 and " << UINT32_MAX << "!\n";
+                    return 1;
+                }
+                break;
+            case 't':
+                num_threads = atoi(optarg);
+                if (num_threads < 1) {
+                    cerr << "Error: the number of threads must be positive!\n";
+                    return 1;
+                }
+                break;
+            case 'w':
+                map_width = atoi(optarg);
+                if (map_width != sizeof(uint32_t) && map_width != sizeof(uint64_t)) {
+                    cerr << "Error: the entry size must be 4 or 8!\n";
+                    return 1;
+                }
+                break;
+            default:
+                print_usage(argv[0]);
+                return 1;
+        }
+    }
+    if (argc - optind < 2) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (!prev_map_path != !delta_path || (merge_path && !prev_map_path)) {
+        cerr << "Error: the delta output needs both a previous component map (-D) and a delta file (-d)!\n";
         return 1;
     }
     
     auto start = high_resolution_clock::now();
+    run_report_t report;
+    report_init(&report, "clustering");
+    if (use_counters && !report_enable_counters(&report)) {
+        cerr << "Warning: hardware counters are not available!\n";
+    }
     
-    igraph_integer_t num_nodes = ((argc >= 4) ? atoi(argv[3]) : 0);
-    igraph_integer_t num_edges;
+    int num_nodes = ((argc - optind >= 3) ? atoi(argv[optind + 2]) : 0);
+    int header_nodes, header_edges;
+    uint64_t num_edges;
 
     // Open the input and output files.
-    FILE *input_file = fopen(argv[1], "r");
+    FILE *input_file = fopen(argv[optind], "r");
     if (!input_file) {
         cerr << "Error: could not open input file!\n";
         return 1;
     }
+    if (!read_graph_header(input_file, &header_nodes, &header_edges)) {
+        cerr << "Error: could not read the graph header!\n";
+        return 1;
+    }
+    if (num_nodes == 0) num_nodes = header_nodes;
         
-    FILE *output_file = fopen(argv[2], "w");
-    if (!output_file) {
+    // Load the previous component map, if any, before the output files
+    // are opened, since one of them may replace it.
+    comp_map_t prev_min;
+    if (prev_map_path) {
+        comp_map_view_t prev_map;
+        phase_begin(&report, "prev_map");
+        if (!map_comp_map_file(prev_map_path, &prev_map)) {
+            cerr << "Error: could not read the previous component map!\n";
+            return 1;
+        }
+        if (!load_min_labels(&prev_map, num_threads, prev_min)) {
+            cerr << "Error: the previous component map contains an invalid component!\n";
+            return 1;
+        }
+        if (prev_min.size() > (size_t) num_nodes) {
+            cerr << "Error: the previous component map has more nodes than the graph!\n";
+            return 1;
+        }
+        phase_end(&report, prev_map.length, prev_min.size());
+        unmap_comp_map_file(&prev_map);
+    }
+
+    // Binary component maps replace the previous file atomically, since
+    // other programs (e.g., the query server) may be reading it.
+    string output_tmp_path, map_tmp_path;
+    int output_fd = (format == FORMAT_BIN) ? open_replacing_output(argv[optind + 1], output_tmp_path) :
+        open_output(argv[optind + 1]);
+    if (output_fd < 0) {
         cerr << "Error: could not open output file!\n";
         return 1;
     }
+    int map_fd = -1;
+    if (map_path && (map_fd = open_replacing_output(map_path, map_tmp_path)) < 0) {
+        cerr << "Error: could not open component map file!\n";
+        return 1;
+    }
+    FILE *stats_file = NULL;
+    if (stats_path && !(stats_file = fopen(stats_path, "w"))) {
+        cerr << "Error: could not open statistics file!\n";
+        return 1;
+    }
+    int index_fd = -1;
+    if (index_path && (index_fd = open_output(index_path)) < 0) {
+        cerr << "Error: could not open index file!\n";
+        return 1;
+    }
+    FILE *report_file = NULL;
+    if (report_path && !(report_file = fopen(report_path, "w"))) {
+        cerr << "Error: could not open report file!\n";
+        return 1;
+    }
+    int delta_fd = -1;
+    if (delta_path && (delta_fd = open_output(delta_path)) < 0) {
+        cerr << "Error: could not open delta file!\n";
+        return 1;
+    }
+    int merge_fd = -1;
+    if (merge_path && (merge_fd = open_output(merge_path)) < 0) {
+        cerr << "Error: could not open merge file!\n";
+        return 1;
+    }
 
-    // Load the graph from the corresponding file.
-    igraph_t graph;
-    read_graph_binary(&graph, input_file, num_nodes);
+    // Compute the weakly connected components of the graph.
+    // The in-memory engines load the graph in a separate phase,
+    // while the streaming ones read the edges while computing the components.
+    uint32_t num_cc;
+    comp_map_t comp_map;
+    io_stats_t io;
+    bool valid = true;
+    uint64_t edge_bytes = (uint64_t) header_edges * 2 * sizeof(uint32_t);
+    switch (engine) {
+        case ENGINE_IGRAPH: {
+            igraph_t graph;
+            phase_begin(&report, "load");
+            read_graph_binary(&graph, input_file, num_nodes, header_edges);
+            num_edges = igraph_ecount(&graph);
+            phase_end(&report, edge_bytes, num_edges);
+            phase_begin(&report, "cc");
+            cc_igraph(&graph, comp_map, &num_cc);
+            igraph_destroy(&graph);
+            phase_end(&report, 0, num_edges);
+            break;
+        }
+        case ENGINE_UF:
+            phase_begin(&report, "cc");
+            valid = cc_union_find(input_file, num_nodes, batch_size, comp_map, &num_cc, &num_edges);
+            phase_end(&report, edge_bytes, num_edges);
+            break;
+        case ENGINE_PAR: {
+            vector<uint32_t> edges;
+            phase_begin(&report, "load");
+            valid = load_edges(input_file, num_nodes, header_edges, edges);
+            num_edges = edges.size() / 2;
+            phase_end(&report, edge_bytes, num_edges);
+            if (!valid) break;
+            phase_begin(&report, "cc");
+            num_cc = parallel_union_find(edges, num_nodes, num_threads, comp_map);
+            phase_end(&report, 0, num_edges);
+            break;
+        }
+        case ENGINE_AFFOREST: {
+            csr_graph_t graph;
+            {
+                vector<uint32_t> edges;
+                phase_begin(&report, "load");
+                valid = load_edges(input_file, num_nodes, header_edges, edges);
+                num_edges = edges.size() / 2;
+                phase_end(&report, edge_bytes, num_edges);
+                if (!valid) break;
+                phase_begin(&report, "csr");
+                build_csr(edges, num_nodes, num_threads, graph);
+                phase_end(&report, graph.adj.size() * sizeof(uint32_t), num_edges);
+            }
+            if (!valid) break;
+            phase_begin(&report, "cc");
+            num_cc = afforest(graph, num_threads, comp_map);
+            phase_end(&report, 0, num_edges);
+            break;
+        }
+        case ENGINE_EXTERNAL: {
+            // The memory budget is split between the two edge buffers, which
+            // need not be larger than the graph (a wrong header only costs more reads).
+            size_t buffer_edges = min(((size_t) buffer_mb << 20) / (4 * sizeof(uint32_t)),
+                (size_t) max(header_edges, 1));
+            phase_begin(&report, "cc");
+            valid = cc_semi_external(input_file, num_nodes, buffer_edges,
+                num_threads, comp_map, &num_cc, &num_edges, &io);
+            phase_end(&report, io.bytes_read, num_edges);
+            break;
+        }
+    }
+    if (!valid) {
+        cerr << "Error: the graph contains an invalid node identifier!\n";
+        return 1;
+    }
     fclose(input_file);
-    num_nodes = igraph_vcount(&graph);
-    num_edges = igraph_ecount(&graph);
 
-    // Compute the weakly connected components of the graph.
-    igraph_integer_t num_cc;
-    igraph_vector_int_t comp_map;
-    //igraph_vector_int_t wcc_sizes;
-    igraph_vector_int_init(&comp_map, num_nodes);
-    //igraph_vector_int_init(&wcc_sizes, total_nodes);
-    igraph_connected_components(&graph, &comp_map, NULL, &num_cc, IGRAPH_WEAK);
-
-    // Write the (node, component) associations to the output file.
-    fprintf(output_file, "node_id,comp_id\n");
-    for (int i = 0; i < num_nodes; i++) {
-        int comp_id = VECTOR(comp_map)[i];
-        fprintf(output_file, "%d,%d\n", i, comp_id);
-    }
-    fclose(output_file);
-
-    // Free the memory occupied by the graph.
-    igraph_destroy(&graph);
-    igraph_vector_int_destroy(&comp_map);
+    // Make the component identifiers canonical, if requested.
+    // The native engines already number the components by rank.
+    if (labels == LABELS_MIN || (labels == LABELS_RANK && engine == ENGINE_IGRAPH)) {
+        phase_begin(&report, "labels");
+        label_by_min_node(comp_map, num_cc, num_threads);
+        if (labels == LABELS_RANK) label_components(comp_map, num_threads);
+        phase_end(&report, 0, num_nodes);
+    }
+
+    // Compute the size of each component, if needed.
+    vector<uint32_t> comp_sizes;
+    if (stats_file || index_fd >= 0 || min_size > 0) {
+        uint32_t num_labels = (labels == LABELS_MIN) ? num_nodes : num_cc;
+        phase_begin(&report, "sizes");
+        count_component_sizes(comp_map, num_labels, num_threads, comp_sizes);
+        phase_end(&report, 0, num_nodes);
+    }
+
+    // Write the (node, component) associations to the output file,
+    // possibly skipping the nodes of small components.
+    node_filter_t filter;
+    filter.sizes = (min_size > 0) ? comp_sizes.data() : NULL;
+    filter.threshold = min_size;
+    // Parallel writes need a seekable output file.
+    struct stat output_stat;
+    int output_threads = (fstat(output_fd, &output_stat) == 0 && S_ISREG(output_stat.st_mode)) ? num_threads : 1;
+    bool written = false;
+    phase_begin(&report, "output");
+    switch (format) {
+        case FORMAT_CSV:
+            written = write_csv(output_fd, comp_map, output_threads, &filter);
+            break;
+        case FORMAT_BIN:
+            written = write_comp_map_binary(output_fd, comp_map, num_cc, map_width);
+            break;
+        case FORMAT_ARROW:
+            written = write_arrow_ipc(output_fd, comp_map, batch_rows, &filter);
+            break;
+        case FORMAT_PARQUET:
+            written = write_parquet(output_fd, comp_map, batch_rows, &filter);
+            break;
+    }
+    if (!written) {
+        cerr << "Error: could not write the output file!\n";
+        return 1;
+    }
+    phase_end(&report, file_size(output_fd), num_nodes);
+    if (format == FORMAT_BIN) {
+        if (!commit_output(output_fd, argv[optind + 1], output_tmp_path)) {
+            cerr << "Error: could not write the output file!\n";
+            return 1;
+        }
+    }
+    else close(output_fd);
+    if (map_fd >= 0) {
+        phase_begin(&report, "map");
+        if (!write_comp_map_binary(map_fd, comp_map, num_cc, map_width)) {
+            cerr << "Error: could not write the component map file!\n";
+            return 1;
+        }
+        phase_end(&report, file_size(map_fd), num_nodes);
+        if (!commit_output(map_fd, map_path, map_tmp_path)) {
+            cerr << "Error: could not write the component map file!\n";
+            return 1;
+        }
+    }
+    if (stats_file) {
+        write_size_report(stats_file, comp_sizes, top_k);
+        fclose(stats_file);
+    }
+    if (index_fd >= 0) {
+        phase_begin(&report, "index");
+        vector<uint32_t> index_offsets, index_members;
+        build_cluster_index(comp_map, comp_sizes, num_threads, index_offsets, index_members);
+        if (!write_cluster_index(index_fd, index_offsets, index_members)) {
+            cerr << "Error: could not write the index file!\n";
+            return 1;
+        }
+        phase_end(&report, file_size(index_fd), num_nodes);
+        close(index_fd);
+    }
     
+    // Compare the components with the previous ones, both identified by their smallest node.
+    delta_stats_t delta;
+    if (prev_map_path) {
+        phase_begin(&report, "delta");
+        comp_map_t cur_min;
+        if (labels != LABELS_MIN) {
+            cur_min = comp_map;
+            label_by_min_node(cur_min, num_cc, num_threads);
+        }
+        if (!write_comp_map_delta(delta_fd, merge_fd, prev_min, (labels == LABELS_MIN) ? comp_map : cur_min,
+            num_threads, &delta)) {
+            cerr << "Error: could not write the delta file!\n";
+            return 1;
+        }
+        phase_end(&report, file_size(delta_fd), num_nodes);
+        close(delta_fd);
+        if (merge_fd >= 0) close(merge_fd);
+    }
+
     auto end = high_resolution_clock::now();
     auto elapsed = duration_cast<nanoseconds>(end - start);
 
+    // Write the report, if requested.
+    if (report_file) {
+        write_report(report_file, &report);
+        fclose(report_file);
+    }
+
     // Print information about the program execution. 
     // Specifically, we print the following values:
     // (1) number of nodes;
     // (2) number of edges;
-    // (3) number of weakly connected components.
-    cout << num_nodes << '\t' << num_edges << '\t' << (int) num_cc << '\t' << elapsed.count() << '\n';
+    // (3) number of weakly connected components;
+    // (4) elapsed time in nanoseconds.
+    // The semi-external engine also reports the number of passes
+    // over the edges and the number of bytes read from the graph file.
+    // With -D, the numbers of changed and new nodes and of merges follow.
+    cout << num_nodes << '\t' << num_edges << '\t' << num_cc << '\t' << elapsed.count();
+    if (engine == ENGINE_EXTERNAL) cout << '\t' << io.passes << '\t' << io.bytes_read;
+    if (prev_map_path) cout << '\t' << delta.changed_nodes << '\t' << delta.new_nodes << '\t' << delta.merges;
+    cout << '\n';
     return 0;
 
 }
\ No newline at end of file
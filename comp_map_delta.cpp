@@ -0,0 +1,123 @@
+/**
+ * @file comp_map_delta.cpp
+ * @author Matteo Loporchio
+ * @brief Changes of the clustering with respect to a previous component map
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#include "comp_map_delta.hpp"
+#include "output.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+using namespace std;
+
+/// @brief Header of the delta file
+static const char delta_header[] = "node_id,comp_id\n";
+
+/// @brief Header of the merge file
+static const char merge_header[] = "comp_id,merged_into\n";
+
+/**
+ * @brief Formats a CSV line made of two integers
+ *
+ * @param dst destination buffer, with room for at least CSV_MAX_LINE characters
+ * @param a the first integer
+ * @param b the second integer
+ * @return the number of characters written
+ */
+static inline size_t format_pair(char *dst, uint32_t a, uint32_t b) {
+    char *p = dst;
+    p += format_uint32(p, a);
+    *p++ = ',';
+    p += format_uint32(p, b);
+    *p++ = '\n';
+    return p - dst;
+}
+
+bool load_min_labels(const comp_map_view_t *view, int num_threads, comp_map_t &min_map) {
+    uint64_t num_nodes = view->header->num_nodes;
+    if (num_nodes > UINT32_MAX) return false;
+    // Copy the entries, checking that they are valid component numbers.
+    // Whatever the numbering, each entry is smaller than the number of nodes.
+    min_map.resize(num_nodes);
+    vector<char> ok(num_threads, 1);
+    uint32_t *map = min_map.data();
+    parallel_for(num_threads, num_nodes, [&](int t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            uint64_t c = comp_map_entry(view, i);
+            if (c >= num_nodes) {
+                ok[t] = 0;
+                return;
+            }
+            map[i] = c;
+        }
+    });
+    for (int t = 0; t < num_threads; t++) {
+        if (!ok[t]) return false;
+    }
+    label_by_min_node(min_map, num_nodes, num_threads);
+    return true;
+}
+
+bool write_comp_map_delta(int delta_fd, int merge_fd, const comp_map_t &prev_min, const comp_map_t &cur_min,
+    int num_threads, delta_stats_t *stats) {
+    if (!write_all(delta_fd, delta_header, sizeof(delta_header) - 1)) return false;
+    if (merge_fd >= 0 && !write_all(merge_fd, merge_header, sizeof(merge_header) - 1)) return false;
+    size_t num_nodes = cur_min.size(), num_prev = prev_min.size();
+    const uint32_t *prev = prev_min.data(), *cur = cur_min.data();
+    vector<vector<char>> node_buf(num_threads), merge_buf(num_threads);
+    vector<size_t> node_len(num_threads), merge_len(num_threads);
+    vector<delta_stats_t> slice_stats(num_threads);
+    for (int t = 0; t < num_threads; t++) {
+        node_buf[t].resize(DELTA_SLICE_NODES * CSV_MAX_LINE);
+        if (merge_fd >= 0) merge_buf[t].resize(DELTA_SLICE_NODES * CSV_MAX_LINE);
+        memset(&slice_stats[t], 0, sizeof(delta_stats_t));
+    }
+    size_t block_size = (size_t) num_threads * DELTA_SLICE_NODES;
+    for (size_t first = 0; first < num_nodes; first += block_size) {
+        size_t n = min(block_size, num_nodes - first);
+        parallel_for(num_threads, n, [&](int t, size_t begin, size_t end) {
+            char *nodes = node_buf[t].data(), *merges = merge_buf[t].data();
+            size_t nl = 0, ml = 0;
+            delta_stats_t *s = &slice_stats[t];
+            for (size_t i = first + begin; i < first + end; i++) {
+                uint32_t c = cur[i];
+                if (i >= num_prev) {
+                    s->new_nodes++;
+                    nl += format_pair(nodes + nl, i, c);
+                    continue;
+                }
+                uint32_t p = prev[i];
+                if (p != c) {
+                    s->changed_nodes++;
+                    nl += format_pair(nodes + nl, i, c);
+                }
+                // A previous component was absorbed if its smallest node no longer identifies a component.
+                if (p == i && c != i) {
+                    s->merges++;
+                    if (merge_fd >= 0) ml += format_pair(merges + ml, i, c);
+                }
+            }
+            node_len[t] = nl;
+            merge_len[t] = ml;
+        });
+        for (int t = 0; t < num_threads; t++) {
+            if (!write_all(delta_fd, node_buf[t].data(), node_len[t])) return false;
+            if (merge_fd >= 0 && !write_all(merge_fd, merge_buf[t].data(), merge_len[t])) return false;
+        }
+    }
+    memset(stats, 0, sizeof(*stats));
+    for (int t = 0; t < num_threads; t++) {
+        stats->changed_nodes += slice_stats[t].changed_nodes;
+        stats->new_nodes += slice_stats[t].new_nodes;
+        stats->merges += slice_stats[t].merges;
+    }
+    return true;
+}
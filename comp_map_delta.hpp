@@ -0,0 +1,75 @@
+/**
+ * @file comp_map_delta.hpp
+ * @author Matteo Loporchio
+ * @brief Changes of the clustering with respect to a previous component map
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Components are compared through their smallest node, which identifies
+ * a component independently of the numbering used by the engine, and
+ * stays the same across runs unless the component is merged with one whose
+ * smallest node is smaller (component numbers by rank, instead, shift
+ * whenever a component appears or disappears before them).
+ *
+ * The delta file lists, as "node_id,comp_id" CSV lines, the nodes whose
+ * component changed and the nodes that did not exist in the previous map,
+ * where comp_id is the smallest node of the current component. The merge
+ * file lists, as "comp_id,merged_into" lines, each previous component that
+ * was absorbed into another one, both identified by their smallest node.
+ *
+ * Nodes are compared in parallel, one block of the map at a time:
+ * each thread formats the lines of its slice of the block into its own
+ * buffer, and the buffers are then written in order.
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#ifndef COMP_MAP_DELTA_HPP
+#define COMP_MAP_DELTA_HPP
+
+#include <cstdint>
+
+#include "comp_map_file.hpp"
+#include "components.hpp"
+
+/// @brief Maximum number of nodes compared by each thread before the lines are written
+#define DELTA_SLICE_NODES (1 << 17)
+
+/// @brief Statistics of the changes between two component maps
+typedef struct {
+    uint64_t changed_nodes;     ///< nodes whose component changed
+    uint64_t new_nodes;         ///< nodes absent from the previous map
+    uint64_t merges;            ///< previous components absorbed into another one
+} delta_stats_t;
+
+/**
+ * @brief Relabels the components of a mapped component map with their smallest node
+ *
+ * The map may use any numbering of the components (engine, min or rank).
+ *
+ * @param view the mapped component map
+ * @param num_threads number of threads
+ * @param min_map receives the smallest node of the component of each node
+ * @return true on success, false if the map has too many nodes or an entry out of range
+ */
+bool load_min_labels(const comp_map_view_t *view, int num_threads, comp_map_t &min_map);
+
+/**
+ * @brief Writes the changes between a previous and a current component map
+ *
+ * Both maps must identify each component by its smallest node
+ * (see label_by_min_node() and load_min_labels()), and the current map
+ * must contain at least as many nodes as the previous one.
+ *
+ * @param delta_fd descriptor of the (already opened) delta file
+ * @param merge_fd descriptor of the (already opened) merge file, or -1 to skip the merge events
+ * @param prev_min the previous component map
+ * @param cur_min the current component map
+ * @param num_threads number of threads
+ * @param stats receives the number of changed and new nodes and of merges
+ * @return true on success, false on error
+ */
+bool write_comp_map_delta(int delta_fd, int merge_fd, const comp_map_t &prev_min, const comp_map_t &cur_min,
+    int num_threads, delta_stats_t *stats);
+
+#endif
@@ -0,0 +1,75 @@
+/**
+ * @file comp_map_file.cpp
+ * @author Matteo Loporchio
+ * @brief Binary component map files
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#include "comp_map_file.hpp"
+#include "output.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+
+bool write_comp_map_binary(int fd, const comp_map_t &comp_map, uint32_t num_cc, uint32_t width) {
+    comp_map_header_t header;
+    memcpy(header.magic, COMP_MAP_MAGIC, sizeof(header.magic));
+    header.version = COMP_MAP_VERSION;
+    header.width = width;
+    header.num_nodes = comp_map.size();
+    header.num_components = num_cc;
+    if (!write_all(fd, (const char *) &header, sizeof(header))) return false;
+    if (width == sizeof(uint32_t)) {
+        return write_all(fd, (const char *) comp_map.data(), comp_map.size() * sizeof(uint32_t));
+    }
+    // Widen the entries one buffer at a time.
+    vector<uint64_t> buf(OUTPUT_BUFFER_SIZE / sizeof(uint64_t));
+    for (size_t begin = 0; begin < comp_map.size(); begin += buf.size()) {
+        size_t n = min(buf.size(), comp_map.size() - begin);
+        for (size_t i = 0; i < n; i++) buf[i] = comp_map[begin + i];
+        if (!write_all(fd, (const char *) buf.data(), n * sizeof(uint64_t))) return false;
+    }
+    return true;
+}
+
+bool map_comp_map_file(const char *path, comp_map_view_t *view) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(comp_map_header_t)) {
+        close(fd);
+        return false;
+    }
+    // The mapping stays valid after the descriptor is closed.
+    void *base = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return false;
+    const comp_map_header_t *header = (const comp_map_header_t *) base;
+    bool valid = memcmp(header->magic, COMP_MAP_MAGIC, sizeof(header->magic)) == 0 &&
+        header->version == COMP_MAP_VERSION &&
+        (header->width == sizeof(uint32_t) || header->width == sizeof(uint64_t)) &&
+        header->num_nodes <= (st.st_size - sizeof(comp_map_header_t)) / header->width;
+    if (!valid) {
+        munmap(base, st.st_size);
+        return false;
+    }
+    view->base = base;
+    view->length = st.st_size;
+    view->header = header;
+    view->entries = (const char *) base + sizeof(comp_map_header_t);
+    return true;
+}
+
+void unmap_comp_map_file(comp_map_view_t *view) {
+    munmap(view->base, view->length);
+}
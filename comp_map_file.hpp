@@ -0,0 +1,91 @@
+/**
+ * @file comp_map_file.hpp
+ * @author Matteo Loporchio
+ * @brief Binary component map files
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * A binary component map file contains a 32-byte header (see comp_map_header_t)
+ * followed by a dense array of unsigned integers, where entry i is the
+ * identifier of the component of node i. Entries are 4 or 8 bytes wide
+ * and stored in the native byte order of the machine that wrote the file.
+ * Since the header size is a multiple of 8, the array is suitably
+ * aligned when the whole file is mapped in memory with mmap.
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#ifndef COMP_MAP_FILE_HPP
+#define COMP_MAP_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "components.hpp"
+
+/// @brief Magic string at the beginning of a binary component map file
+#define COMP_MAP_MAGIC "CCMAP\0\0\0"
+
+/// @brief Current version of the binary component map format
+#define COMP_MAP_VERSION 1
+
+/// @brief Header of a binary component map file
+typedef struct {
+    char magic[8];              ///< COMP_MAP_MAGIC
+    uint32_t version;           ///< COMP_MAP_VERSION
+    uint32_t width;             ///< size of each entry in bytes (4 or 8)
+    uint64_t num_nodes;         ///< number of entries
+    uint64_t num_components;    ///< number of components
+} comp_map_header_t;
+
+/// @brief Binary component map file mapped in memory
+typedef struct {
+    void *base;                         ///< start of the mapping
+    size_t length;                      ///< length of the mapping in bytes
+    const comp_map_header_t *header;    ///< header of the file
+    const void *entries;                ///< array of entries (4 or 8 bytes each, see header->width)
+} comp_map_view_t;
+
+/**
+ * @brief Returns the component of a node in a mapped component map
+ *
+ * @param view the mapped component map
+ * @param node the node (smaller than header->num_nodes)
+ */
+inline uint64_t comp_map_entry(const comp_map_view_t *view, uint64_t node) {
+    if (view->header->width == sizeof(uint32_t)) return ((const uint32_t *) view->entries)[node];
+    return ((const uint64_t *) view->entries)[node];
+}
+
+/**
+ * @brief Writes a binary component map file
+ *
+ * With 4-byte entries, the component map is written directly from memory.
+ *
+ * @param fd descriptor of the (already opened) output file
+ * @param comp_map the component map
+ * @param num_cc number of components
+ * @param width size of each entry in bytes (4 or 8)
+ * @return true on success, false on error
+ */
+bool write_comp_map_binary(int fd, const comp_map_t &comp_map, uint32_t num_cc, uint32_t width);
+
+/**
+ * @brief Maps a binary component map file in memory (read-only)
+ *
+ * The header is checked and the file must be long enough to hold all the entries.
+ *
+ * @param path path of the file
+ * @param view receives the mapping
+ * @return true on success, false if the file cannot be mapped or is not a valid component map
+ */
+bool map_comp_map_file(const char *path, comp_map_view_t *view);
+
+/**
+ * @brief Unmaps a binary component map file
+ *
+ * @param view the mapping
+ */
+void unmap_comp_map_file(comp_map_view_t *view);
+
+#endif
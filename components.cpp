@@ -0,0 +1,441 @@
+/**
+ * @file components.cpp
+ * @author Matteo Loporchio
+ * @brief Native engines for computing the connected components of the auxiliary graph
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#include "components.hpp"
+#include "graph_file.hpp"
+#include "parallel.hpp"
+
+#include <fcntl.h>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+using namespace std;
+
+/// @brief Number of neighbors of each node linked before sampling the largest component in Afforest
+#define AFFOREST_NEIGHBOR_ROUNDS 2
+
+/// @brief Number of nodes sampled by Afforest to identify the largest component
+#define AFFOREST_NUM_SAMPLES 1024
+
+/**
+ * @brief Finds the root of the tree containing a node, halving the path along the way
+ *
+ * @param parent the union-find forest
+ * @param x the node
+ * @return the root of the tree containing x
+ */
+static inline uint32_t uf_find(uint32_t *parent, uint32_t x) {
+    uint32_t p;
+    while (!((p = parent[x]) & UF_ROOT)) {
+        uint32_t gp = parent[p];
+        if (gp & UF_ROOT) return p;
+        parent[x] = gp;
+        x = gp;
+    }
+    return x;
+}
+
+/**
+ * @brief Merges the trees containing two nodes, attaching the smaller tree to the larger one
+ *
+ * @param parent the union-find forest
+ * @param a the first node
+ * @param b the second node
+ */
+static inline void uf_union(uint32_t *parent, uint32_t a, uint32_t b) {
+    a = uf_find(parent, a);
+    b = uf_find(parent, b);
+    if (a == b) return;
+    uint32_t size_a = parent[a] & ~UF_ROOT, size_b = parent[b] & ~UF_ROOT;
+    if (size_a < size_b) swap(a, b);
+    parent[a] = UF_ROOT | (size_a + size_b);
+    parent[b] = a;
+}
+
+/**
+ * @brief Turns the union-find forest into a map from each node to the smallest node of its tree
+ *
+ * @param parent the union-find forest, overwritten with the result
+ * @param num_nodes number of nodes
+ */
+static void uf_flatten(uint32_t *parent, uint32_t num_nodes) {
+    // First, make every node point directly to its root.
+    for (uint32_t i = 0; i < num_nodes; i++) {
+        if (!(parent[i] & UF_ROOT)) parent[i] = uf_find(parent, i);
+    }
+    // Then, scan the nodes in increasing order. The first node of each tree
+    // is its smallest one: it becomes the new root and the old root is redirected to it.
+    for (uint32_t i = 0; i < num_nodes; i++) {
+        if (parent[i] & UF_ROOT) parent[i] = i;
+        else {
+            uint32_t r = parent[i];
+            if (parent[r] & UF_ROOT) {
+                parent[r] = i;
+                parent[i] = i;
+            }
+            else parent[i] = parent[r];
+        }
+    }
+}
+
+uint32_t label_components(comp_map_t &comp_map, int num_threads) {
+    uint32_t num_cc = 0;
+    if (num_threads <= 1) {
+        for (size_t i = 0; i < comp_map.size(); i++) {
+            // The smallest node of a component is always visited first.
+            if (comp_map[i] == i) comp_map[i] = num_cc++;
+            else comp_map[i] = comp_map[comp_map[i]];
+        }
+        return num_cc;
+    }
+    // Count the components whose smallest node falls in each slice.
+    uint32_t *map = comp_map.data();
+    vector<uint32_t> base(num_threads + 1, 0);
+    parallel_for(num_threads, comp_map.size(), [&](int t, size_t begin, size_t end) {
+        uint32_t count = 0;
+        for (size_t i = begin; i < end; i++) count += (map[i] == i);
+        base[t + 1] = count;
+    });
+    for (int t = 0; t < num_threads; t++) base[t + 1] += base[t];
+    // Label the smallest nodes, marking them so that they can be told apart from the others.
+    parallel_for(num_threads, comp_map.size(), [&](int t, size_t begin, size_t end) {
+        uint32_t label = base[t];
+        for (size_t i = begin; i < end; i++) {
+            if (map[i] == i) map[i] = UF_ROOT | label++;
+        }
+    });
+    // Propagate the labels to the remaining nodes and remove the marks.
+    parallel_for(num_threads, comp_map.size(), [&](int t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            if (!(map[i] & UF_ROOT)) map[i] = map[map[i]] & ~UF_ROOT;
+        }
+    });
+    parallel_for(num_threads, comp_map.size(), [&](int t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) map[i] &= ~UF_ROOT;
+    });
+    return base[num_threads];
+}
+
+void label_by_min_node(comp_map_t &comp_map, uint32_t num_cc, int num_threads) {
+    vector<uint32_t> min_node(num_cc, UINT32_MAX);
+    uint32_t *map = comp_map.data(), *min_ptr = min_node.data();
+    parallel_for(num_threads, comp_map.size(), [&](int t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            // Nodes are visited in increasing order, so only the first node
+            // of each component in the slice may lower its minimum.
+            uint32_t *m = &min_ptr[map[i]];
+            uint32_t curr = __atomic_load_n(m, __ATOMIC_RELAXED);
+            while (i < curr && !__atomic_compare_exchange_n(m, &curr, (uint32_t) i, false,
+                __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+        }
+    });
+    parallel_for(num_threads, comp_map.size(), [&](int t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) map[i] = min_ptr[map[i]];
+    });
+}
+
+void uf_init(comp_map_t &parent, uint32_t num_nodes) {
+    // Initially, each node is a tree of size one.
+    parent.assign(num_nodes, UF_ROOT | 1);
+}
+
+void uf_grow(comp_map_t &parent, uint32_t num_nodes) {
+    if (num_nodes > parent.size()) parent.resize(num_nodes, UF_ROOT | 1);
+}
+
+/// @brief State of an edge being processed by the batched union-find kernel
+typedef struct {
+    uint32_t a, b;      ///< endpoints of the edge
+    uint32_t xa, xb;    ///< current positions of the two finds
+} uf_slot_t;
+
+/**
+ * @brief Processes a sequence of edges, interleaving the finds of several edges
+ *
+ * Each slot advances its two finds by one hop per round and prefetches the
+ * next parent, so that the cache misses of up to 2 * batch_size finds overlap.
+ * When both finds of a slot have reached a root, the trees are merged, the
+ * endpoints are pointed directly to the new root and the slot takes the next edge.
+ *
+ * @param parent the union-find forest
+ * @param edges array of (source, target) pairs
+ * @param num_edges number of edges
+ * @param batch_size number of edges processed concurrently
+ */
+static void uf_union_edges_batched(uint32_t *parent, const uint32_t *edges, size_t num_edges,
+    int batch_size) {
+    vector<uf_slot_t> slots(batch_size);
+    size_t next = 0;
+    int active = 0;
+    for (; active < batch_size && next < num_edges; active++, next++) {
+        uf_slot_t &slot = slots[active];
+        slot.a = slot.xa = edges[2*next];
+        slot.b = slot.xb = edges[2*next+1];
+        __builtin_prefetch(&parent[slot.xa], 1);
+        __builtin_prefetch(&parent[slot.xb], 1);
+    }
+    while (active > 0) {
+        for (int s = 0; s < active; ) {
+            uf_slot_t &slot = slots[s];
+            uint32_t pa = parent[slot.xa], pb = parent[slot.xb];
+            if (!(pa & UF_ROOT)) {
+                slot.xa = pa;
+                __builtin_prefetch(&parent[pa], 1);
+            }
+            if (!(pb & UF_ROOT)) {
+                slot.xb = pb;
+                __builtin_prefetch(&parent[pb], 1);
+            }
+            if (!(pa & pb & UF_ROOT)) {
+                s++;
+                continue;
+            }
+            // Both finds have reached a root: merge the trees.
+            uint32_t root = slot.xa;
+            if (slot.xa != slot.xb) {
+                uint32_t size_a = pa & ~UF_ROOT, size_b = pb & ~UF_ROOT;
+                uint32_t child = slot.xb;
+                if (size_a < size_b) swap(root, child);
+                parent[root] = UF_ROOT | (size_a + size_b);
+                parent[child] = root;
+            }
+            if (slot.a != root) parent[slot.a] = root;
+            if (slot.b != root) parent[slot.b] = root;
+            // Refill the slot, or shrink the batch if there are no more edges.
+            if (next < num_edges) {
+                slot.a = slot.xa = edges[2*next];
+                slot.b = slot.xb = edges[2*next+1];
+                __builtin_prefetch(&parent[slot.xa], 1);
+                __builtin_prefetch(&parent[slot.xb], 1);
+                next++;
+                s++;
+            }
+            else slots[s] = slots[--active];
+        }
+    }
+}
+
+void uf_union_edges(uint32_t *parent, const uint32_t *edges, size_t num_edges, int batch_size) {
+    if (batch_size > 0) uf_union_edges_batched(parent, edges, num_edges, batch_size);
+    else {
+        for (size_t i = 0; i < num_edges; i++) uf_union(parent, edges[2*i], edges[2*i+1]);
+    }
+}
+
+uint32_t uf_finish(comp_map_t &parent) {
+    uf_flatten(parent.data(), parent.size());
+    return label_components(parent);
+}
+
+bool cc_union_find(FILE *input_file, uint32_t num_nodes, int batch_size, comp_map_t &comp_map,
+    uint32_t *num_cc, uint64_t *num_edges) {
+    uf_init(comp_map, num_nodes);
+    vector<uint32_t> buf(2 * EDGE_CHUNK_SIZE);
+    size_t num_read;
+    *num_edges = 0;
+    while ((num_read = read_edges(input_file, buf.data(), EDGE_CHUNK_SIZE)) > 0) {
+        for (size_t i = 0; i < 2 * num_read; i++) {
+            if (buf[i] >= num_nodes) return false;
+        }
+        uf_union_edges(comp_map.data(), buf.data(), num_read, batch_size);
+        *num_edges += num_read;
+    }
+    *num_cc = uf_finish(comp_map);
+    return true;
+}
+
+/**
+ * @brief Finds the root of the tree containing a node in the concurrent union-find forest
+ *
+ * Every node points to a node with a smaller or equal identifier, and the roots point
+ * to themselves. Path halving may race with other threads, but it only ever replaces
+ * a parent with one of its ancestors, so a lost update is harmless.
+ *
+ * @param parent the union-find forest
+ * @param x the node
+ * @return the root of the tree containing x
+ */
+static inline uint32_t cuf_find(uint32_t *parent, uint32_t x) {
+    uint32_t p = __atomic_load_n(&parent[x], __ATOMIC_RELAXED);
+    while (p != x) {
+        uint32_t gp = __atomic_load_n(&parent[p], __ATOMIC_RELAXED);
+        if (gp != p) __atomic_store_n(&parent[x], gp, __ATOMIC_RELAXED);
+        x = p;
+        p = gp;
+    }
+    return x;
+}
+
+/**
+ * @brief Merges the trees containing two nodes in the concurrent union-find forest
+ *
+ * The root with the larger identifier is attached to the other one
+ * by a compare-and-swap, which fails (and is retried) if that root
+ * has meanwhile been attached to another tree.
+ *
+ * @param parent the union-find forest
+ * @param a the first node
+ * @param b the second node
+ */
+static inline void cuf_union(uint32_t *parent, uint32_t a, uint32_t b) {
+    while (true) {
+        a = cuf_find(parent, a);
+        b = cuf_find(parent, b);
+        if (a == b) return;
+        if (a < b) swap(a, b);
+        uint32_t expected = a;
+        if (__atomic_compare_exchange_n(&parent[a], &expected, b, false,
+            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) return;
+    }
+}
+
+/**
+ * @brief Makes every node of the concurrent union-find forest point directly to its root
+ *
+ * @param parent the union-find forest
+ * @param num_nodes number of nodes
+ * @param num_threads number of threads
+ */
+static void cuf_compress(uint32_t *parent, uint32_t num_nodes, int num_threads) {
+    parallel_for(num_threads, num_nodes, [&](int t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            __atomic_store_n(&parent[i], cuf_find(parent, i), __ATOMIC_RELAXED);
+        }
+    });
+}
+
+bool load_edges(FILE *input_file, uint32_t num_nodes, uint64_t header_edges,
+    vector<uint32_t> &edges) {
+    read_all_edges(input_file, edges, header_edges);
+    for (size_t i = 0; i < edges.size(); i++) {
+        if (edges[i] >= num_nodes) return false;
+    }
+    return true;
+}
+
+uint32_t parallel_union_find(const vector<uint32_t> &edges, uint32_t num_nodes, int num_threads,
+    comp_map_t &comp_map) {
+    // Initially, each node is the root of its own tree.
+    comp_map.resize(num_nodes);
+    uint32_t *parent = comp_map.data();
+    parallel_for(num_threads, num_nodes, [&](int t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) parent[i] = i;
+    });
+    const uint32_t *e = edges.data();
+    parallel_for(num_threads, edges.size() / 2, [&](int t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) cuf_union(parent, e[2*i], e[2*i+1]);
+    });
+    // Each root is the smallest node of its tree: make every node point to it.
+    cuf_compress(parent, num_nodes, num_threads);
+    return label_components(comp_map, num_threads);
+}
+
+/**
+ * @brief Finds the most frequent root among a random sample of nodes
+ *
+ * @param parent the (compressed) union-find forest
+ * @param num_nodes number of nodes
+ * @return the root of the (likely) largest component
+ */
+static uint32_t sample_frequent_root(const uint32_t *parent, uint32_t num_nodes) {
+    unordered_map<uint32_t, uint32_t> counts;
+    mt19937 gen(27491095);
+    uniform_int_distribution<uint32_t> dist(0, num_nodes - 1);
+    uint32_t best = parent[0], best_count = 0;
+    for (int i = 0; i < AFFOREST_NUM_SAMPLES; i++) {
+        uint32_t r = parent[dist(gen)];
+        uint32_t c = ++counts[r];
+        if (c > best_count) {
+            best = r;
+            best_count = c;
+        }
+    }
+    return best;
+}
+
+uint32_t afforest(const csr_graph_t &graph, int num_threads, comp_map_t &comp_map) {
+    uint32_t num_nodes = graph.num_nodes;
+    const uint64_t *offsets = graph.offsets.data();
+    const uint32_t *adj = graph.adj.data();
+    comp_map.resize(num_nodes);
+    uint32_t *parent = comp_map.data();
+    if (num_nodes == 0) return 0;
+    parallel_for(num_threads, num_nodes, [&](int t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) parent[i] = i;
+    });
+    // Link each node to its first few neighbors.
+    for (int r = 0; r < AFFOREST_NEIGHBOR_ROUNDS; r++) {
+        parallel_for(num_threads, num_nodes, [&](int t, size_t begin, size_t end) {
+            for (size_t u = begin; u < end; u++) {
+                if (offsets[u] + r < offsets[u+1]) cuf_union(parent, u, adj[offsets[u] + r]);
+            }
+        });
+        cuf_compress(parent, num_nodes, num_threads);
+    }
+    // Process the remaining neighbors of the nodes outside the largest component.
+    // Since every edge is stored in both directions, the edges between that
+    // component and the other nodes are still seen from the other endpoint.
+    uint32_t giant = sample_frequent_root(parent, num_nodes);
+    parallel_for(num_threads, num_nodes, [&](int t, size_t begin, size_t end) {
+        for (size_t u = begin; u < end; u++) {
+            if (cuf_find(parent, u) == giant) continue;
+            for (uint64_t k = offsets[u] + AFFOREST_NEIGHBOR_ROUNDS; k < offsets[u+1]; k++) {
+                cuf_union(parent, u, adj[k]);
+            }
+        }
+    });
+    cuf_compress(parent, num_nodes, num_threads);
+    return label_components(comp_map, num_threads);
+}
+
+bool cc_semi_external(FILE *input_file, uint32_t num_nodes, size_t buffer_edges,
+    int num_threads, comp_map_t &comp_map, uint32_t *num_cc, uint64_t *num_edges,
+    io_stats_t *io) {
+    posix_fadvise(fileno(input_file), 0, 0, POSIX_FADV_SEQUENTIAL);
+    comp_map.resize(num_nodes);
+    uint32_t *parent = comp_map.data();
+    parallel_for(num_threads, num_nodes, [&](int t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) parent[i] = i;
+    });
+    vector<uint32_t> buf[2];
+    buf[0].resize(2 * buffer_edges);
+    buf[1].resize(2 * buffer_edges);
+    size_t num_read[2];
+    bool valid = true;
+    *num_edges = 0;
+    io->passes = 1;
+    io->bytes_read = 2 * sizeof(uint32_t);
+    num_read[0] = read_edges(input_file, buf[0].data(), buffer_edges);
+    for (int curr = 0; num_read[curr] > 0; curr = 1 - curr) {
+        // Read the next chunk while processing the current one.
+        int next = 1 - curr;
+        thread reader([&]() {
+            num_read[next] = read_edges(input_file, buf[next].data(), buffer_edges);
+        });
+        const uint32_t *e = buf[curr].data();
+        for (size_t i = 0; i < 2 * num_read[curr]; i++) {
+            if (e[i] >= num_nodes) valid = false;
+        }
+        if (valid) {
+            parallel_for(num_threads, num_read[curr], [&](int t, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) cuf_union(parent, e[2*i], e[2*i+1]);
+            });
+        }
+        reader.join();
+        if (!valid) return false;
+        *num_edges += num_read[curr];
+        io->bytes_read += 2 * sizeof(uint32_t) * num_read[curr];
+    }
+    cuf_compress(parent, num_nodes, num_threads);
+    *num_cc = label_components(comp_map, num_threads);
+    return true;
+}
@@ -0,0 +1,199 @@
+/**
+ * @file components.hpp
+ * @author Matteo Loporchio
+ * @brief Native engines for computing the connected components of the auxiliary graph
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * The engines declared here compute the same partition as
+ * igraph_connected_components without building an igraph_t.
+ * Components are numbered in order of their smallest node,
+ * i.e., the component containing node 0 has identifier 0,
+ * the component containing the smallest node not in component 0
+ * has identifier 1, and so on. This is also the numbering produced by igraph.
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#ifndef COMPONENTS_HPP
+#define COMPONENTS_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "csr.hpp"
+
+/// @brief The component map associates each node with the identifier of its component
+typedef std::vector<uint32_t> comp_map_t;
+
+/// @brief Marks the root of a tree in the union-find forest; the remaining bits hold the tree size
+#define UF_ROOT 0x80000000u
+
+/**
+ * @brief Numbers the components of a graph in order of their smallest node
+ *
+ * On input, each entry of the map must contain the smallest node of the
+ * corresponding component. On output, each entry contains the component identifier.
+ *
+ * @param comp_map the component map, relabeled in place
+ * @param num_threads number of threads
+ * @return the number of components
+ */
+uint32_t label_components(comp_map_t &comp_map, int num_threads = 1);
+
+/**
+ * @brief Relabels each component with its smallest node
+ *
+ * This makes the component map independent of the engine that computed it.
+ * The smallest node of each component is found by a parallel scan.
+ * Calling label_components() afterwards yields the canonical numbering
+ * of the components in order of their smallest node.
+ *
+ * @param comp_map the component map, with identifiers in [0, num_cc), relabeled in place
+ * @param num_cc number of components
+ * @param num_threads number of threads
+ */
+void label_by_min_node(comp_map_t &comp_map, uint32_t num_cc, int num_threads);
+
+/**
+ * @brief Initializes a sequential union-find forest in which each node is a separate tree
+ *
+ * The forest is stored in a component map: roots are marked by the most
+ * significant bit and hold the size of their tree in the remaining bits,
+ * while the other nodes hold their parent.
+ *
+ * @param parent the union-find forest
+ * @param num_nodes number of nodes
+ */
+void uf_init(comp_map_t &parent, uint32_t num_nodes);
+
+/**
+ * @brief Adds new nodes to a sequential union-find forest, each as a separate tree
+ *
+ * The existing trees are left untouched, so a forest can be extended
+ * as new node identifiers appear (e.g., when new transactions are ingested).
+ *
+ * @param parent the union-find forest
+ * @param num_nodes new number of nodes (not smaller than the current one)
+ */
+void uf_grow(comp_map_t &parent, uint32_t num_nodes);
+
+/**
+ * @brief Merges the endpoints of a sequence of edges in a sequential union-find forest
+ *
+ * Trees are merged by size and paths are shortened by halving. If batch_size
+ * is positive, the finds of batch_size consecutive edges are interleaved and
+ * the parents they visit are prefetched, hiding the latency of cache misses
+ * on large forests. Otherwise, the edges are processed one at a time.
+ *
+ * @param parent the union-find forest
+ * @param edges array of (source, target) pairs, all smaller than the number of nodes
+ * @param num_edges number of edges
+ * @param batch_size number of edges processed concurrently (0 for the plain loop)
+ */
+void uf_union_edges(uint32_t *parent, const uint32_t *edges, size_t num_edges, int batch_size);
+
+/**
+ * @brief Turns a sequential union-find forest into a component map
+ *
+ * @param parent the union-find forest, overwritten with the component of each node
+ * @return the number of components
+ */
+uint32_t uf_finish(comp_map_t &parent);
+
+/**
+ * @brief Computes the connected components with a sequential union-find
+ *
+ * Edges are streamed from the graph file in chunks. The union-find forest
+ * (union by size, path halving) is stored in the component map itself,
+ * so the memory footprint is about 4 bytes per node.
+ *
+ * @param input_file pointer to the binary graph file, positioned after the header
+ * @param num_nodes number of nodes of the graph
+ * @param batch_size number of edges whose finds are interleaved (see uf_union_edges())
+ * @param comp_map receives the component of each node
+ * @param num_cc receives the number of components
+ * @param num_edges receives the number of edges read from the file
+ * @return false if an edge refers to a node outside [0, num_nodes), true otherwise
+ */
+bool cc_union_find(FILE *input_file, uint32_t num_nodes, int batch_size, comp_map_t &comp_map,
+    uint32_t *num_cc, uint64_t *num_edges);
+
+/**
+ * @brief Loads all the edges of a graph file and checks their node identifiers
+ *
+ * @param input_file pointer to the binary graph file, positioned after the header
+ * @param num_nodes number of nodes of the graph
+ * @param header_edges number of edges declared in the header of the graph file
+ * @param edges receives the (source, target) pairs
+ * @return false if an edge refers to a node outside [0, num_nodes), true otherwise
+ */
+bool load_edges(FILE *input_file, uint32_t num_nodes, uint64_t header_edges,
+    std::vector<uint32_t> &edges);
+
+/**
+ * @brief Computes the connected components with a concurrent union-find
+ *
+ * Each thread processes a slice of the edge array. Trees are linked with
+ * compare-and-swap operations, always attaching the root with the larger
+ * identifier to the root with the smaller one (Rem's algorithm), so no
+ * locks are needed. A final parallel pass compresses all paths and
+ * numbers the components.
+ *
+ * @param edges the (source, target) pairs, see load_edges()
+ * @param num_nodes number of nodes of the graph
+ * @param num_threads number of threads
+ * @param comp_map receives the component of each node
+ * @return the number of components
+ */
+uint32_t parallel_union_find(const std::vector<uint32_t> &edges, uint32_t num_nodes, int num_threads,
+    comp_map_t &comp_map);
+
+/**
+ * @brief Computes the connected components of a graph in CSR format with Afforest
+ *
+ * Afforest (Sutton et al., 2018) first links every node to a small number of
+ * its neighbors, which is usually enough to assemble the largest component,
+ * identifies that component by sampling, and then processes the remaining
+ * edges of the nodes outside it only. On graphs with a giant component
+ * this skips most of the edges.
+ *
+ * @param graph the graph in CSR format
+ * @param num_threads number of threads
+ * @param comp_map receives the component of each node
+ * @return the number of components
+ */
+uint32_t afforest(const csr_graph_t &graph, int num_threads, comp_map_t &comp_map);
+
+/// @brief I/O statistics of the semi-external engine
+typedef struct {
+    uint64_t passes;        ///< number of sequential passes over the edges of the graph file
+    uint64_t bytes_read;    ///< number of bytes read from the graph file
+} io_stats_t;
+
+/**
+ * @brief Computes the connected components in semi-external memory
+ *
+ * Only the concurrent union-find forest (4 bytes per node) is kept in memory,
+ * while the edges are streamed sequentially from the graph file through two
+ * buffers of buffer_edges edges each: one is filled by a reader thread while
+ * the edges of the other are processed by num_threads threads.
+ * A single pass over the file is enough, since union-find never needs
+ * to revisit an edge.
+ *
+ * @param input_file pointer to the binary graph file, positioned after the header
+ * @param num_nodes number of nodes of the graph
+ * @param buffer_edges number of edges held by each buffer
+ * @param num_threads number of threads
+ * @param comp_map receives the component of each node
+ * @param num_cc receives the number of components
+ * @param num_edges receives the number of edges read from the file
+ * @param io receives the I/O statistics
+ * @return false if an edge refers to a node outside [0, num_nodes), true otherwise
+ */
+bool cc_semi_external(FILE *input_file, uint32_t num_nodes, size_t buffer_edges,
+    int num_threads, comp_map_t &comp_map, uint32_t *num_cc, uint64_t *num_edges,
+    io_stats_t *io);
+
+#endif
@@ -0,0 +1,40 @@
+/**
+ * @file csr.cpp
+ * @author Matteo Loporchio
+ * @brief Compressed sparse row (CSR) representation of the auxiliary graph
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#include "csr.hpp"
+#include "parallel.hpp"
+
+using namespace std;
+
+void build_csr(const vector<uint32_t> &edges, uint32_t num_nodes, int num_threads,
+    csr_graph_t &graph) {
+    graph.num_nodes = num_nodes;
+    graph.offsets.assign((size_t) num_nodes + 1, 0);
+    graph.adj.resize(edges.size());
+    uint64_t *offsets = graph.offsets.data();
+    uint32_t *adj = graph.adj.data();
+    const uint32_t *e = edges.data();
+    // Compute the degree of each node (shifted by one position).
+    parallel_for(num_threads, edges.size(), [&](int t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) __atomic_fetch_add(&offsets[e[i] + 1], 1, __ATOMIC_RELAXED);
+    });
+    // Turn the degrees into offsets.
+    for (uint32_t u = 0; u < num_nodes; u++) offsets[u + 1] += offsets[u];
+    // Scatter the edges, using a copy of the offsets as insertion cursors.
+    vector<uint64_t> cursor(graph.offsets.begin(), graph.offsets.end() - 1);
+    uint64_t *pos = cursor.data();
+    parallel_for(num_threads, edges.size() / 2, [&](int t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            uint32_t u = e[2*i], v = e[2*i+1];
+            adj[__atomic_fetch_add(&pos[u], 1, __ATOMIC_RELAXED)] = v;
+            adj[__atomic_fetch_add(&pos[v], 1, __ATOMIC_RELAXED)] = u;
+        }
+    });
+}
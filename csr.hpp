@@ -0,0 +1,40 @@
+/**
+ * @file csr.hpp
+ * @author Matteo Loporchio
+ * @brief Compressed sparse row (CSR) representation of the auxiliary graph
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Since the auxiliary graph is undirected, every edge (u, v) appears
+ * twice in the CSR: v among the neighbors of u and u among the neighbors of v.
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#ifndef CSR_HPP
+#define CSR_HPP
+
+#include <cstdint>
+#include <vector>
+
+/// @brief Undirected graph in CSR format
+typedef struct {
+    uint32_t num_nodes;             ///< number of nodes
+    std::vector<uint64_t> offsets;  ///< neighbors of node u are adj[offsets[u]], ..., adj[offsets[u+1]-1]
+    std::vector<uint32_t> adj;      ///< concatenated adjacency lists
+} csr_graph_t;
+
+/**
+ * @brief Builds the CSR representation of an undirected graph from its edge array
+ *
+ * The order of the neighbors within each adjacency list is unspecified.
+ *
+ * @param edges array of (source, target) pairs
+ * @param num_nodes number of nodes (all identifiers in the edge array must be smaller)
+ * @param num_threads number of threads
+ * @param graph receives the CSR representation
+ */
+void build_csr(const std::vector<uint32_t> &edges, uint32_t num_nodes, int num_threads,
+    csr_graph_t &graph);
+
+#endif
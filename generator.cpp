@@ -0,0 +1,87 @@
+/**
+ * @file generator.cpp
+ * @author Matteo Loporchio
+ * @brief Generates synthetic transaction files for the builder
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * This program writes a chain of synthetic transactions (see synthetic.hpp)
+ * in the textual format read by the builder. It is used to benchmark the
+ * whole pipeline on inputs of arbitrary size (see scaling.py).
+ *
+ * At the end, the program prints a tab-separated line with the number of
+ * transactions, the number of addresses and the elapsed time in nanoseconds.
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <unistd.h>
+#include <vector>
+
+#include "output.hpp"
+#include "synthetic.hpp"
+
+using namespace std;
+using namespace std::chrono;
+
+int main(int argc, char **argv) {
+    uint64_t seed = 1;
+    int opt;
+    while ((opt = getopt(argc, argv, "s:")) != -1) {
+        switch (opt) {
+            case 's':
+                seed = strtoull(optarg, NULL, 10);
+                break;
+            default:
+                cerr << "Usage: " << argv[0] << " [-s <seed>] <num_tx> <output_file>\n";
+                return 1;
+        }
+    }
+    if (argc - optind < 2) {
+        cerr << "Usage: " << argv[0] << " [-s <seed>] <num_tx> <output_file>\n";
+        return 1;
+    }
+    uint64_t num_tx = strtoull(argv[optind], NULL, 10);
+    if (num_tx > UINT32_MAX) {
+        cerr << "Error: the number of transactions must be smaller than 2^32!\n";
+        return 1;
+    }
+
+    auto start = high_resolution_clock::now();
+
+    // Open the output file ("-" for the standard output).
+    FILE *output_file = strcmp(argv[optind + 1], "-") ? fopen(argv[optind + 1], "w") : stdout;
+    if (!output_file) {
+        cerr << "Error: could not open output file!\n";
+        return 1;
+    }
+    // Fill a large buffer with whole lines before each write.
+    vector<char> buf(OUTPUT_BUFFER_SIZE + SYNTHETIC_MAX_LINE);
+    size_t used = 0;
+    chain_generator_t chain;
+    chain_init(&chain, seed);
+    for (uint64_t t = 0; t < num_tx; t++) {
+        used += chain_next(&chain, buf.data() + used);
+        if (used >= OUTPUT_BUFFER_SIZE || t + 1 == num_tx) {
+            if (fwrite(buf.data(), 1, used, output_file) != used) {
+                cerr << "Error: could not write the output file!\n";
+                return 1;
+            }
+            used = 0;
+        }
+    }
+    if (fclose(output_file) != 0) {
+        cerr << "Error: could not write the output file!\n";
+        return 1;
+    }
+
+    auto end = high_resolution_clock::now();
+    auto elapsed = duration_cast<nanoseconds>(end - start);
+    cout << num_tx << '\t' << chain.num_addresses << '\t' << elapsed.count() << '\n';
+    return 0;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file graph_file.cpp
+ * @author Matteo Loporchio
+ * @brief Streaming access to the binary graph files produced by the builder
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#include "graph_file.hpp"
+
+bool read_graph_header(FILE *input_file, int *num_nodes, int *num_edges) {
+    int buf[2];
+    if (fread(buf, sizeof(int), 2, input_file) != 2) return false;
+    *num_nodes = __builtin_bswap32(buf[0]);
+    *num_edges = __builtin_bswap32(buf[1]);
+    return true;
+}
+
+size_t read_edges(FILE *input_file, uint32_t *buf, size_t max_edges) {
+    // Incomplete trailing pairs are ignored.
+    size_t num_read = fread(buf, sizeof(uint32_t), 2 * max_edges, input_file) / 2;
+    for (size_t i = 0; i < 2 * num_read; i++) buf[i] = __builtin_bswap32(buf[i]);
+    return num_read;
+}
+
+void read_all_edges(FILE *input_file, std::vector<uint32_t> &edges, size_t num_edges) {
+    edges.resize(2 * num_edges);
+    size_t total = 0, num_read;
+    while (true) {
+        // Grow the array if the file contains more edges than declared.
+        if (total == edges.size() / 2) edges.resize(2 * (total + EDGE_CHUNK_SIZE));
+        num_read = read_edges(input_file, edges.data() + 2 * total, edges.size() / 2 - total);
+        if (num_read == 0) break;
+        total += num_read;
+    }
+    edges.resize(2 * total);
+}
+
+bool write_graph_header(FILE *output_file, int num_nodes, int num_edges) {
+    int buf[2];
+    buf[0] = __builtin_bswap32(num_nodes);
+    buf[1] = __builtin_bswap32(num_edges);
+    return fwrite(buf, sizeof(int), 2, output_file) == 2;
+}
+
+bool write_graph_edges(FILE *output_file, const std::pair<int,int> *edges, size_t num_edges) {
+    int buf[2];
+    for (size_t i = 0; i < num_edges; i++) {
+        buf[0] = __builtin_bswap32(edges[i].first);
+        buf[1] = __builtin_bswap32(edges[i].second);
+        if (fwrite(buf, sizeof(int), 2, output_file) != 2) return false;
+    }
+    return true;
+}
+
+bool write_graph(FILE *output_file, int num_nodes, const edge_list_t &edges) {
+    // First, write the number of nodes and edges, then the list of edges.
+    return write_graph_header(output_file, num_nodes, edges.size()) &&
+        write_graph_edges(output_file, edges.data(), edges.size());
+}
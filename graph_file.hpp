@@ -0,0 +1,92 @@
+/**
+ * @file graph_file.hpp
+ * @author Matteo Loporchio
+ * @brief Streaming access to the binary graph files produced by the builder
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * The graph file is a sequence of 32-bit signed big-endian integers:
+ * the number of nodes N, the number of edges M and then M pairs
+ * of node identifiers (see builder.cpp). The functions below allow
+ * reading the edges in fixed-size chunks, so that the whole edge list
+ * never needs to be held in memory at once, and writing a graph
+ * from its (sorted and deduplicated) edge list.
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#ifndef GRAPH_FILE_HPP
+#define GRAPH_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+/// @brief Default number of edges read from the graph file at once
+#define EDGE_CHUNK_SIZE (1 << 20)
+
+/// @brief The edge list contains ordered pairs representing graph edges
+typedef std::vector<std::pair<int,int>> edge_list_t;
+
+/**
+ * @brief Reads the header of a binary graph file
+ *
+ * @param input_file pointer to the (already opened) binary file
+ * @param num_nodes number of nodes stored in the header
+ * @param num_edges number of edges stored in the header
+ * @return true if the header could be read, false otherwise
+ */
+bool read_graph_header(FILE *input_file, int *num_nodes, int *num_edges);
+
+/**
+ * @brief Reads the next chunk of edges from a binary graph file
+ *
+ * @param input_file pointer to the binary file, positioned after the header
+ * @param buf buffer of at least 2 * max_edges integers, receiving (source, target) pairs in host byte order
+ * @param max_edges maximum number of edges to read
+ * @return the number of edges actually read (zero at the end of the file)
+ */
+size_t read_edges(FILE *input_file, uint32_t *buf, size_t max_edges);
+
+/**
+ * @brief Reads all the remaining edges of a binary graph file into memory
+ *
+ * @param input_file pointer to the binary file, positioned after the header
+ * @param edges receives the (source, target) pairs in host byte order
+ * @param num_edges number of edges declared in the header, used to size the array
+ */
+void read_all_edges(FILE *input_file, std::vector<uint32_t> &edges, size_t num_edges);
+
+/**
+ * @brief Writes the header of a binary graph file
+ *
+ * @param output_file pointer to the (already opened) binary file
+ * @param num_nodes number of nodes of the graph
+ * @param num_edges number of edges of the graph
+ * @return true on success, false on error
+ */
+bool write_graph_header(FILE *output_file, int num_nodes, int num_edges);
+
+/**
+ * @brief Appends a sequence of edges to a binary graph file
+ *
+ * @param output_file pointer to the binary file, positioned after the header or the previous edges
+ * @param edges array of edges
+ * @param num_edges number of edges
+ * @return true on success, false on error
+ */
+bool write_graph_edges(FILE *output_file, const std::pair<int,int> *edges, size_t num_edges);
+
+/**
+ * @brief Writes a graph to a binary file
+ *
+ * @param output_file pointer to the (already opened) binary file
+ * @param num_nodes number of nodes of the graph
+ * @param edges list of graph edges, without duplicates
+ * @return true on success, false on error
+ */
+bool write_graph(FILE *output_file, int num_nodes, const edge_list_t &edges);
+
+#endif
@@ -0,0 +1,45 @@
+/**
+ * @file igraph_engine.cpp
+ * @author Matteo Loporchio
+ * @brief Connected components of the auxiliary graph with igraph (reference engine)
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#include "igraph_engine.hpp"
+#include "memory_usage.hpp"
+
+void read_graph_binary(igraph_t *graph, FILE *input_file, int num_nodes, int num_edges) {
+    int buf[2];
+    int num_read;
+    // Initialize the graph.
+    igraph_empty(graph, (igraph_integer_t) num_nodes, IGRAPH_UNDIRECTED);
+    // Read edges from the input file and add them to the graph.
+    igraph_vector_int_t edges;
+    igraph_vector_int_init(&edges, 2 * num_edges);
+    record_allocation(2 * (size_t) num_edges * sizeof(igraph_integer_t));
+    igraph_integer_t i = 0;
+    while ((num_read = fread(buf, sizeof(int), 2, input_file)) > 0) {
+        VECTOR(edges)[i] = (igraph_integer_t) (__builtin_bswap32(buf[0]));
+        VECTOR(edges)[i+1] = (igraph_integer_t) (__builtin_bswap32(buf[1]));
+        i += 2;
+    }
+    igraph_add_edges(graph, &edges, NULL);
+    igraph_vector_int_destroy(&edges);
+}
+
+void cc_igraph(const igraph_t *graph, comp_map_t &comp_map, uint32_t *num_cc) {
+    // Compute the weakly connected components of the graph.
+    igraph_integer_t num_nodes = igraph_vcount(graph);
+    igraph_integer_t igraph_num_cc;
+    igraph_vector_int_t igraph_comp_map;
+    igraph_vector_int_init(&igraph_comp_map, num_nodes);
+    record_allocation(num_nodes * sizeof(igraph_integer_t));
+    igraph_connected_components(graph, &igraph_comp_map, NULL, &igraph_num_cc, IGRAPH_WEAK);
+    comp_map.resize(num_nodes);
+    for (igraph_integer_t i = 0; i < num_nodes; i++) comp_map[i] = VECTOR(igraph_comp_map)[i];
+    igraph_vector_int_destroy(&igraph_comp_map);
+    *num_cc = igraph_num_cc;
+}
@@ -0,0 +1,38 @@
+/**
+ * @file igraph_engine.hpp
+ * @author Matteo Loporchio
+ * @brief Connected components of the auxiliary graph with igraph (reference engine)
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#ifndef IGRAPH_ENGINE_HPP
+#define IGRAPH_ENGINE_HPP
+
+#include <cstdio>
+#include <igraph.h>
+
+#include "components.hpp"
+
+/**
+ * @brief Reads the auxiliary graph from a binary file
+ * 
+ * @param graph igraph data structure where the graph will be stored
+ * @param input_file pointer to the (already opened) binary file, positioned after the header
+ * @param num_nodes number of nodes of the input graph
+ * @param num_edges number of edges declared in the header of the input file
+ */
+void read_graph_binary(igraph_t *graph, FILE *input_file, int num_nodes, int num_edges);
+
+/**
+ * @brief Computes the connected components of the auxiliary graph with igraph
+ * 
+ * @param graph the graph, loaded with read_graph_binary()
+ * @param comp_map receives the component of each node
+ * @param num_cc receives the number of components
+ */
+void cc_igraph(const igraph_t *graph, comp_map_t &comp_map, uint32_t *num_cc);
+
+#endif
@@ -0,0 +1,378 @@
+/**
+ * @file incremental.cpp
+ * @author Matteo Loporchio
+ * @brief Incremental address clustering with a persistent union-find state
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * This program maintains the clustering of the addresses of a transaction file
+ * that keeps growing (e.g., with the transactions of each new day).
+ * Instead of rebuilding the auxiliary graph and recomputing its components
+ * from scratch, it keeps the union-find forest of the previous run in a state
+ * file (see uf_state.hpp), together with the number of bytes of the
+ * transaction file already processed. Each run loads the state, seeks past
+ * the processed prefix, merges the input addresses of the new transactions
+ * (multi-input heuristic), saves the state back and writes the updated
+ * clustering. The cost of a run is thus proportional to the number of new
+ * transactions plus a linear scan of the forest, rather than to the whole history.
+ *
+ * If the state file does not exist, the whole input file is processed.
+ * With -n, the input file only contains new transactions (e.g., a daily
+ * delta) and is read from its beginning. The offset of the state is left
+ * unchanged, so that delta files and the growing transaction file
+ * can still be alternated.
+ *
+ * Only complete (newline-terminated) lines are processed: a partial last line,
+ * e.g., one that is still being appended, is left for the next run.
+ *
+ * The output file has the same format as the one of the clustering program
+ * with canonical identifiers (-c rank), so the two can be compared byte by byte.
+ * As in the clustering program, the changes with respect to a previous
+ * binary component map can be written with -D, -d and -M.
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "comp_map_delta.hpp"
+#include "comp_map_file.hpp"
+#include "components.hpp"
+#include "output.hpp"
+#include "parallel.hpp"
+#include "report.hpp"
+#include "transactions.hpp"
+#include "uf_state.hpp"
+
+using namespace std;
+using namespace std::chrono;
+
+/// @brief Formats of the output file
+enum output_format_t {
+    FORMAT_CSV,         ///< one "node_id,comp_id" line per node
+    FORMAT_BIN          ///< binary component map (see comp_map_file.hpp)
+};
+
+/**
+ * @brief Prints the usage message of the program
+ *
+ * @param name name of the executable
+ */
+void print_usage(const char *name) {
+    cerr << "Usage: " << name << " [options] <state_file> <input_file> <output_file>\n"
+        << "Options:\n"
+        << "  -n                the input file only contains new transactions (read from its beginning)\n"
+        << "  -b <batch_size>   number of interleaved finds of the union-find (default: 16)\n"
+        << "  -f <format>       format of the output file: csv (default) or bin\n"
+        << "  -w <width>        size in bytes of the binary component map entries: 4 (default) or 8\n"
+        << "  -t <num_threads>  number of threads (default: number of hardware threads)\n"
+        << "  -D <prev_map>     compare the components with those of a previous binary component map\n"
+        << "  -d <delta_file>   write the nodes whose component changed, or that are new, to delta_file (with -D)\n"
+        << "  -M <merge_file>   write the previous components merged into other ones to merge_file (with -D)\n"
+        << "  -j <report_file>  write a JSON report with the time, throughput and memory of each phase to report_file\n"
+        << "  -H                include the hardware counters of each phase in the report\n";
+}
+
+/**
+ * @brief Returns the size of an open file, or 0 if it is not a regular file
+ *
+ * @param fd the file descriptor
+ */
+uint64_t file_size(int fd) {
+    struct stat st;
+    return (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) ? st.st_size : 0;
+}
+
+/**
+ * @brief Merges the endpoints of a list of edges in the union-find forest and clears the list
+ *
+ * @param state the union-find state, grown to include all the nodes seen so far
+ * @param edges the edges
+ * @param batch_size number of interleaved finds (see uf_union_edges())
+ * @param buf buffer holding the edges as consecutive endpoints
+ */
+void merge_edges(uf_state_t *state, edge_list_t &edges, int batch_size, vector<uint32_t> &buf) {
+    uf_grow(state->parent, state->max_id + 1);
+    buf.resize(2 * edges.size());
+    for (size_t i = 0; i < edges.size(); i++) {
+        buf[2*i] = edges[i].first;
+        buf[2*i+1] = edges[i].second;
+    }
+    uf_union_edges(state->parent.data(), buf.data(), edges.size(), batch_size);
+    edges.clear();
+}
+
+int main(int argc, char **argv) {
+    bool delta_input = false;
+    int batch_size = 16;
+    output_format_t format = FORMAT_CSV;
+    uint32_t map_width = sizeof(uint32_t);
+    int num_threads = default_num_threads();
+    const char *prev_map_path = NULL;
+    const char *delta_path = NULL;
+    const char *merge_path = NULL;
+    const char *report_path = NULL;
+    bool use_counters = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "b:D:d:f:Hj:M:nt:w:")) != -1) {
+        switch (opt) {
+            case 'b':
+                batch_size = atoi(optarg);
+                if (batch_size < 0) {
+                    cerr << "Error: the batch size must be non-negative!\n";
+                    return 1;
+                }
+                break;
+            case 'D':
+                prev_map_path = optarg;
+                break;
+            case 'd':
+                delta_path = optarg;
+                break;
+            case 'f':
+                if (!strcmp(optarg, "csv")) format = FORMAT_CSV;
+                else if (!strcmp(optarg, "bin")) format = FORMAT_BIN;
+                else {
+                    cerr << "Error: unknown output format " << optarg << "!\n";
+                    return 1;
+                }
+                break;
+            case 'H':
+                use_counters = true;
+                break;
+            case 'j':
+                report_path = optarg;
+                break;
+            case 'M':
+                merge_path = optarg;
+                break;
+            case 'n':
+                delta_input = true;
+                break;
+            case 't':
+                num_threads = atoi(optarg);
+                if (num_threads < 1) {
+                    cerr << "Error: the number of threads must be positive!\n";
+                    return 1;
+                }
+                break;
+            case 'w':
+                map_width = atoi(optarg);
+                if (map_width != sizeof(uint32_t) && map_width != sizeof(uint64_t)) {
+                    cerr << "Error: the entry size must be 4 or 8!\n";
+                    return 1;
+                }
+                break;
+            default:
+                print_usage(argv[0]);
+                return 1;
+        }
+    }
+    if (argc - optind < 3) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (!prev_map_path != !delta_path || (merge_path && !prev_map_path)) {
+        cerr << "Error: the delta output needs both a previous component map (-D) and a delta file (-d)!\n";
+        return 1;
+    }
+    const char *state_path = argv[optind];
+
+    auto start = high_resolution_clock::now();
+    run_report_t report;
+    report_init(&report, "incremental");
+    if (use_counters && !report_enable_counters(&report)) {
+        cerr << "Warning: hardware counters are not available!\n";
+    }
+
+    // Load the state of the previous run, if any.
+    uf_state_t state;
+    phase_begin(&report, "load");
+    FILE *state_file = fopen(state_path, "rb");
+    if (state_file) {
+        bool valid = read_uf_state(state_file, &state);
+        fclose(state_file);
+        if (!valid) {
+            cerr << "Error: could not read the state file!\n";
+            return 1;
+        }
+    }
+    else if (errno == ENOENT) uf_state_init(&state);
+    else {
+        cerr << "Error: could not open state file!\n";
+        return 1;
+    }
+    phase_end(&report, state.parent.size() * sizeof(uint32_t), state.parent.size());
+
+    // Load the previous component map, if any, before the output files
+    // are opened, since one of them may replace it.
+    comp_map_t prev_min;
+    if (prev_map_path) {
+        comp_map_view_t prev_map;
+        phase_begin(&report, "prev_map");
+        if (!map_comp_map_file(prev_map_path, &prev_map)) {
+            cerr << "Error: could not read the previous component map!\n";
+            return 1;
+        }
+        if (!load_min_labels(&prev_map, num_threads, prev_min)) {
+            cerr << "Error: the previous component map contains an invalid component!\n";
+            return 1;
+        }
+        phase_end(&report, prev_map.length, prev_min.size());
+        unmap_comp_map_file(&prev_map);
+    }
+
+    // Open the input file.
+    FILE *input_file = fopen(argv[optind + 1], "r");
+    if (!input_file) {
+        cerr << "Error: could not open input file!\n";
+        return 1;
+    }
+    if (!delta_input && state.input_offset > 0) {
+        // The processed prefix must still be there: a shorter file is not the one of the previous runs.
+        if (file_size(fileno(input_file)) < state.input_offset) {
+            cerr << "Error: the input file is shorter than the part already processed!\n";
+            return 1;
+        }
+        if (fseeko(input_file, state.input_offset, SEEK_SET) != 0) {
+            cerr << "Error: could not seek in the input file!\n";
+            return 1;
+        }
+    }
+    // Parse the new transactions and merge the input addresses of each one.
+    // Edges are accumulated in chunks, so that the finds can be interleaved.
+    phase_begin(&report, "ingest");
+    edge_list_t edges;
+    vector<uint32_t> buf;
+    char *line_buf = NULL;
+    size_t line_size = 0;
+    ssize_t line_length;
+    uint64_t new_bytes = 0, new_tx = 0;
+    bool partial_line = false;
+    while ((line_length = getline(&line_buf, &line_size, input_file)) > 0) {
+        if (line_buf[line_length - 1] != '\n') {
+            partial_line = true;
+            break;
+        }
+        process_line(line_buf, &state.max_id, edges);
+        new_bytes += line_length;
+        new_tx++;
+        if (edges.size() >= EDGE_CHUNK_SIZE) merge_edges(&state, edges, batch_size, buf);
+    }
+    merge_edges(&state, edges, batch_size, buf);
+    free(line_buf);
+    fclose(input_file);
+    if (!delta_input) state.input_offset += new_bytes;
+    state.num_tx += new_tx;
+    phase_end(&report, new_bytes, new_tx);
+    if (partial_line) cerr << "Warning: the last line of the input file is incomplete and was skipped!\n";
+
+    // Check the previous map and open the output files only now, so that
+    // an error leaves the outputs and the state untouched.
+    if (prev_min.size() > state.parent.size()) {
+        cerr << "Error: the previous component map has more nodes than the state!\n";
+        return 1;
+    }
+    // A binary component map replaces the previous file atomically, since
+    // other programs (e.g., the query server) may be reading it.
+    string output_tmp_path;
+    int output_fd = (format == FORMAT_BIN) ? open_replacing_output(argv[optind + 2], output_tmp_path) :
+        open(argv[optind + 2], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (output_fd < 0) {
+        cerr << "Error: could not open output file!\n";
+        return 1;
+    }
+    FILE *report_file = NULL;
+    if (report_path && !(report_file = fopen(report_path, "w"))) {
+        cerr << "Error: could not open report file!\n";
+        return 1;
+    }
+    int delta_fd = -1;
+    if (delta_path && (delta_fd = open(delta_path, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0) {
+        cerr << "Error: could not open delta file!\n";
+        return 1;
+    }
+    int merge_fd = -1;
+    if (merge_path && (merge_fd = open(merge_path, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0) {
+        cerr << "Error: could not open merge file!\n";
+        return 1;
+    }
+
+    // Save the updated state.
+    phase_begin(&report, "save");
+    if (!write_uf_state(state_path, &state)) {
+        cerr << "Error: could not write the state file!\n";
+        return 1;
+    }
+    phase_end(&report, sizeof(uf_state_header_t) + state.parent.size() * sizeof(uint32_t), state.parent.size());
+
+    // Number the components in order of their smallest node.
+    // The forest is kept intact, since flattening it would destroy the tree sizes.
+    phase_begin(&report, "labels");
+    comp_map_t comp_map = state.parent;
+    uint32_t num_cc = uf_finish(comp_map);
+    uint32_t num_nodes = comp_map.size();
+    phase_end(&report, 0, num_nodes);
+
+    // Write the (node, component) associations to the output file.
+    // Parallel writes need a seekable output file.
+    struct stat output_stat;
+    int output_threads = (fstat(output_fd, &output_stat) == 0 && S_ISREG(output_stat.st_mode)) ? num_threads : 1;
+    phase_begin(&report, "output");
+    bool written = (format == FORMAT_CSV) ? write_csv(output_fd, comp_map, output_threads) :
+        write_comp_map_binary(output_fd, comp_map, num_cc, map_width);
+    if (!written) {
+        cerr << "Error: could not write the output file!\n";
+        return 1;
+    }
+    phase_end(&report, file_size(output_fd), num_nodes);
+    if (format == FORMAT_BIN) {
+        if (!commit_output(output_fd, argv[optind + 2], output_tmp_path)) {
+            cerr << "Error: could not write the output file!\n";
+            return 1;
+        }
+    }
+    else close(output_fd);
+
+    // Compare the components with the previous ones, both identified by their smallest node.
+    delta_stats_t delta;
+    if (prev_map_path) {
+        phase_begin(&report, "delta");
+        label_by_min_node(comp_map, num_cc, num_threads);
+        if (!write_comp_map_delta(delta_fd, merge_fd, prev_min, comp_map, num_threads, &delta)) {
+            cerr << "Error: could not write the delta file!\n";
+            return 1;
+        }
+        phase_end(&report, file_size(delta_fd), num_nodes);
+        close(delta_fd);
+        if (merge_fd >= 0) close(merge_fd);
+    }
+
+    auto end = high_resolution_clock::now();
+    auto elapsed = duration_cast<nanoseconds>(end - start);
+
+    // Write the report, if requested.
+    if (report_file) {
+        write_report(report_file, &report);
+        fclose(report_file);
+    }
+
+    // Print the number of nodes, the number of new transactions,
+    // the total number of transactions, the number of components
+    // and the elapsed time in nanoseconds. With -D, the numbers
+    // of changed and new nodes and of merges follow.
+    cout << num_nodes << '\t' << new_tx << '\t' << state.num_tx << '\t' << num_cc << '\t' << elapsed.count();
+    if (prev_map_path) cout << '\t' << delta.changed_nodes << '\t' << delta.new_nodes << '\t' << delta.merges;
+    cout << '\n';
+    return 0;
+}
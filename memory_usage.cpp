@@ -0,0 +1,89 @@
+/**
+ * @file memory_usage.cpp
+ * @author Matteo Loporchio
+ * @brief Resident memory and large allocation accounting
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#include "memory_usage.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <sys/resource.h>
+
+using namespace std;
+
+/// @brief Statistics of the large allocations (updated with relaxed atomics)
+static alloc_stats_t large_allocs = {0, 0, 0};
+
+void record_allocation(size_t bytes) {
+    if (bytes < LARGE_ALLOC_BYTES) return;
+    __atomic_fetch_add(&large_allocs.count, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&large_allocs.bytes, bytes, __ATOMIC_RELAXED);
+    uint64_t largest = __atomic_load_n(&large_allocs.largest, __ATOMIC_RELAXED);
+    while (bytes > largest && !__atomic_compare_exchange_n(&large_allocs.largest, &largest, bytes,
+        true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+void get_alloc_stats(alloc_stats_t *stats) {
+    stats->count = __atomic_load_n(&large_allocs.count, __ATOMIC_RELAXED);
+    stats->bytes = __atomic_load_n(&large_allocs.bytes, __ATOMIC_RELAXED);
+    stats->largest = __atomic_load_n(&large_allocs.largest, __ATOMIC_RELAXED);
+}
+
+void reset_largest_allocation() {
+    __atomic_store_n(&large_allocs.largest, 0, __ATOMIC_RELAXED);
+}
+
+uint64_t max_rss_bytes() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss;
+#else
+    return (uint64_t) usage.ru_maxrss << 10;
+#endif
+}
+
+void sample_rss(rss_sample_t *sample) {
+    sample->rss_bytes = 0;
+    sample->peak_rss_bytes = 0;
+    FILE *status = fopen("/proc/self/status", "r");
+    if (!status) {
+        sample->peak_rss_bytes = max_rss_bytes();
+        return;
+    }
+    char line[256];
+    unsigned long long kb;
+    while (fgets(line, sizeof(line), status)) {
+        if (sscanf(line, "VmRSS: %llu kB", &kb) == 1) sample->rss_bytes = kb << 10;
+        else if (sscanf(line, "VmHWM: %llu kB", &kb) == 1) sample->peak_rss_bytes = kb << 10;
+    }
+    fclose(status);
+}
+
+bool reset_peak_rss() {
+    FILE *clear_refs = fopen("/proc/self/clear_refs", "w");
+    if (!clear_refs) return false;
+    bool reset = (fputs("5", clear_refs) >= 0);
+    return (fclose(clear_refs) == 0) && reset;
+}
+
+// Replacement of the global allocation functions. The array, nothrow and
+// sized variants of the standard library are implemented on top of these.
+
+void *operator new(size_t size) {
+    void *ptr = malloc(size ? size : 1);
+    if (!ptr) throw bad_alloc();
+    if (size >= LARGE_ALLOC_BYTES) record_allocation(size);
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept {
+    free(ptr);
+}
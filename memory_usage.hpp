@@ -0,0 +1,81 @@
+/**
+ * @file memory_usage.hpp
+ * @author Matteo Loporchio
+ * @brief Resident memory and large allocation accounting
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * The resident set size (current and peak) is sampled from /proc/self/status
+ * on Linux and from getrusage elsewhere (where the current value is unknown).
+ * On Linux, the peak can also be reset, so that the high-water mark of each
+ * phase of a program can be measured separately.
+ *
+ * Linking memory_usage.o into a program replaces the global operator new,
+ * which counts every allocation of at least LARGE_ALLOC_BYTES bytes
+ * (e.g., each growth of a large std::vector). Allocations made with malloc,
+ * e.g., by igraph, are not seen and can be recorded with record_allocation().
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#ifndef MEMORY_USAGE_HPP
+#define MEMORY_USAGE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/// @brief Minimum size of the allocations that are counted
+#define LARGE_ALLOC_BYTES (1 << 20)
+
+/// @brief Resident set size of the process
+typedef struct {
+    uint64_t rss_bytes;         ///< current resident set size (0 if unknown)
+    uint64_t peak_rss_bytes;    ///< peak resident set size since the start or the last reset
+} rss_sample_t;
+
+/// @brief Statistics of the large allocations
+typedef struct {
+    uint64_t count;             ///< number of large allocations
+    uint64_t bytes;             ///< total size of the large allocations
+    uint64_t largest;           ///< size of the largest allocation
+} alloc_stats_t;
+
+/**
+ * @brief Samples the resident set size of the process
+ *
+ * @param sample receives the current and peak resident set size
+ */
+void sample_rss(rss_sample_t *sample);
+
+/**
+ * @brief Resets the peak resident set size to the current one (Linux only)
+ *
+ * @return true on success, false if the peak cannot be reset
+ */
+bool reset_peak_rss();
+
+/**
+ * @brief Returns the peak resident set size of the process, as reported by getrusage
+ */
+uint64_t max_rss_bytes();
+
+/**
+ * @brief Records an allocation not made through operator new, if it is large
+ *
+ * @param bytes size of the allocation
+ */
+void record_allocation(size_t bytes);
+
+/**
+ * @brief Reads the statistics of the large allocations made so far
+ *
+ * @param stats receives the statistics
+ */
+void get_alloc_stats(alloc_stats_t *stats);
+
+/**
+ * @brief Resets the size of the largest allocation (e.g., at the start of a phase)
+ */
+void reset_largest_allocation();
+
+#endif
@@ -0,0 +1,208 @@
+/**
+ * @file output.cpp
+ * @author Matteo Loporchio
+ * @brief Writers for the output files of the analyzer
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#include "output.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "parallel.hpp"
+
+using namespace std;
+
+/// @brief Header line of the CSV file
+static const char csv_header[] = "node_id,comp_id\n";
+
+/// @brief Decimal representations of all integers from 0 to 99, two characters each
+static const char digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+size_t format_uint32(char *dst, uint32_t value) {
+    // Fill a temporary buffer from the end, two digits at a time.
+    char tmp[10];
+    char *p = tmp + 10;
+    while (value >= 100) {
+        uint32_t pair = value % 100;
+        value /= 100;
+        p -= 2;
+        memcpy(p, digit_pairs + 2 * pair, 2);
+    }
+    if (value >= 10) {
+        p -= 2;
+        memcpy(p, digit_pairs + 2 * value, 2);
+    }
+    else *--p = '0' + value;
+    size_t len = tmp + 10 - p;
+    memcpy(dst, p, len);
+    return len;
+}
+
+/**
+ * @brief Returns the number of decimal digits of an integer
+ *
+ * @param value the integer
+ */
+static inline size_t num_digits(uint32_t value) {
+    size_t n = 1;
+    while (value >= 100) {
+        value /= 100;
+        n += 2;
+    }
+    return n + (value >= 10);
+}
+
+size_t format_csv_lines(char *dst, const uint32_t *comp_map, uint32_t begin, uint32_t end,
+    const node_filter_t *filter) {
+    char *p = dst;
+    for (uint32_t i = begin; i < end; i++) {
+        if (!node_selected(filter, comp_map[i])) continue;
+        p += format_uint32(p, i);
+        *p++ = ',';
+        p += format_uint32(p, comp_map[i]);
+        *p++ = '\n';
+    }
+    return p - dst;
+}
+
+bool write_all(int fd, const char *buf, size_t size) {
+    while (size > 0) {
+        ssize_t written = write(fd, buf, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        buf += written;
+        size -= written;
+    }
+    return true;
+}
+
+bool read_all(int fd, char *buf, size_t size) {
+    while (size > 0) {
+        ssize_t n = read(fd, buf, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        buf += n;
+        size -= n;
+    }
+    return true;
+}
+
+int open_replacing_output(const char *path, string &tmp_path) {
+    struct stat st;
+    tmp_path.clear();
+    if (stat(path, &st) == 0 && !S_ISREG(st.st_mode)) return open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    tmp_path = string(path) + ".tmp";
+    return open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+}
+
+bool commit_output(int fd, const char *path, const string &tmp_path) {
+    if (tmp_path.empty()) return close(fd) == 0;
+    bool committed = (fsync(fd) == 0);
+    committed = (close(fd) == 0) && committed;
+    committed = committed && (rename(tmp_path.c_str(), path) == 0);
+    if (!committed) unlink(tmp_path.c_str());
+    return committed;
+}
+
+bool pwrite_all(int fd, const char *buf, size_t size, uint64_t offset) {
+    while (size > 0) {
+        ssize_t written = pwrite(fd, buf, size, offset);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        buf += written;
+        size -= written;
+        offset += written;
+    }
+    return true;
+}
+
+/**
+ * @brief Formats the CSV lines of a range of nodes and writes them with pwrite
+ *
+ * @param fd the file descriptor
+ * @param comp_map the component map
+ * @param begin first node of the range
+ * @param end node following the last one of the range
+ * @param offset position of the first line in the file
+ * @param filter selects the nodes to write
+ * @return true on success, false on error
+ */
+static bool pwrite_csv_lines(int fd, const uint32_t *comp_map, uint32_t begin, uint32_t end,
+    uint64_t offset, const node_filter_t *filter) {
+    vector<char> buf(OUTPUT_BUFFER_SIZE);
+    while (begin < end) {
+        uint32_t chunk_end = begin + OUTPUT_BUFFER_SIZE / CSV_MAX_LINE;
+        if (chunk_end > end || chunk_end < begin) chunk_end = end;
+        size_t len = format_csv_lines(buf.data(), comp_map, begin, chunk_end, filter);
+        if (!pwrite_all(fd, buf.data(), len, offset)) return false;
+        offset += len;
+        begin = chunk_end;
+    }
+    return true;
+}
+
+bool write_csv(int fd, const comp_map_t &comp_map, int num_threads, const node_filter_t *filter) {
+    size_t header_len = sizeof(csv_header) - 1;
+    uint32_t num_nodes = comp_map.size();
+    if (num_threads > 1) {
+        // Compute the length of the text of each range.
+        const uint32_t *map = comp_map.data();
+        vector<uint64_t> offset(num_threads + 1, 0);
+        parallel_for(num_threads, num_nodes, [&](int t, size_t begin, size_t end) {
+            uint64_t len = 0;
+            for (size_t i = begin; i < end; i++) {
+                if (node_selected(filter, map[i])) len += num_digits(i) + num_digits(map[i]) + 2;
+            }
+            offset[t + 1] = len;
+        });
+        offset[0] = header_len;
+        for (int t = 0; t < num_threads; t++) offset[t + 1] += offset[t];
+        // Write all ranges concurrently.
+        vector<char> ok(num_threads, 1);
+        if (!pwrite_all(fd, csv_header, header_len, 0)) return false;
+        parallel_for(num_threads, num_nodes, [&](int t, size_t begin, size_t end) {
+            ok[t] = pwrite_csv_lines(fd, map, begin, end, offset[t], filter);
+        });
+        for (int t = 0; t < num_threads; t++) {
+            if (!ok[t]) return false;
+        }
+        return true;
+    }
+    vector<char> buf(OUTPUT_BUFFER_SIZE);
+    size_t len = header_len;
+    memcpy(buf.data(), csv_header, len);
+    for (uint32_t begin = 0; begin < num_nodes; ) {
+        // Leave room for the header in the first buffer.
+        uint32_t end = begin + (OUTPUT_BUFFER_SIZE - len) / CSV_MAX_LINE;
+        if (end > num_nodes || end < begin) end = num_nodes;
+        len += format_csv_lines(buf.data() + len, comp_map.data(), begin, end, filter);
+        if (!write_all(fd, buf.data(), len)) return false;
+        len = 0;
+        begin = end;
+    }
+    return write_all(fd, buf.data(), len);
+}
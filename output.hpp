@@ -0,0 +1,144 @@
+/**
+ * @file output.hpp
+ * @author Matteo Loporchio
+ * @brief Writers for the output files of the analyzer
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#ifndef OUTPUT_HPP
+#define OUTPUT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "components.hpp"
+
+/// @brief Size of the buffers used by the writers
+#define OUTPUT_BUFFER_SIZE (1 << 22)
+
+/// @brief Maximum length of a CSV line ("node_id,comp_id\n" with 10 digits each)
+#define CSV_MAX_LINE 22
+
+/// @brief Selects the nodes written to the output, based on the size of their component
+typedef struct {
+    const uint32_t *sizes;      ///< size of each component (NULL to select all nodes)
+    uint32_t threshold;         ///< only the nodes of components larger than threshold are selected
+} node_filter_t;
+
+/**
+ * @brief Tells whether the nodes of a component are selected by a filter
+ *
+ * @param filter the filter (NULL to select all nodes)
+ * @param comp_id the component
+ */
+inline bool node_selected(const node_filter_t *filter, uint32_t comp_id) {
+    return !filter || !filter->sizes || filter->sizes[comp_id] > filter->threshold;
+}
+
+/**
+ * @brief Writes the decimal representation of an integer
+ *
+ * Digits are produced two at a time from a lookup table.
+ *
+ * @param dst destination buffer, with room for at least 10 characters
+ * @param value the integer
+ * @return the number of characters written
+ */
+size_t format_uint32(char *dst, uint32_t value);
+
+/**
+ * @brief Formats the CSV lines of a range of nodes
+ *
+ * @param dst destination buffer, with room for at least CSV_MAX_LINE characters per node
+ * @param comp_map the component map
+ * @param begin first node of the range
+ * @param end node following the last one of the range
+ * @param filter selects the nodes to format (NULL for all nodes)
+ * @return the number of characters written
+ */
+size_t format_csv_lines(char *dst, const uint32_t *comp_map, uint32_t begin, uint32_t end,
+    const node_filter_t *filter = NULL);
+
+/**
+ * @brief Writes a buffer to a file descriptor, retrying on partial writes
+ *
+ * @param fd the file descriptor
+ * @param buf the buffer
+ * @param size number of bytes to write
+ * @return true on success, false on error
+ */
+bool write_all(int fd, const char *buf, size_t size);
+
+/**
+ * @brief Reads exactly the given number of bytes from a file descriptor, retrying on partial reads
+ *
+ * @param fd the file descriptor
+ * @param buf destination buffer
+ * @param size number of bytes to read
+ * @return true on success, false at the end of the file or on error
+ */
+bool read_all(int fd, char *buf, size_t size);
+
+/**
+ * @brief Opens an output file that atomically replaces the given path when committed
+ *
+ * If the path is a regular file or does not exist, the output is written to
+ * path.tmp, which commit_output() syncs and renames over the path, so that
+ * readers of the previous file (e.g., the query server, which maps it in
+ * memory) never see a truncated or partial file. Other paths (e.g., pipes
+ * or terminals) are opened directly.
+ *
+ * @param path path of the output file
+ * @param tmp_path receives the path of the temporary file (empty if the path is opened directly)
+ * @return the file descriptor, or -1 on error
+ */
+int open_replacing_output(const char *path, std::string &tmp_path);
+
+/**
+ * @brief Closes an output file opened with open_replacing_output(), replacing the given path
+ *
+ * @param fd the file descriptor
+ * @param path path of the output file
+ * @param tmp_path path of the temporary file (empty if the path was opened directly)
+ * @return true on success, false on error (the temporary file is then removed)
+ */
+bool commit_output(int fd, const char *path, const std::string &tmp_path);
+
+/**
+ * @brief Writes a buffer at a given offset of a file, retrying on partial writes
+ *
+ * @param fd the file descriptor
+ * @param buf the buffer
+ * @param size number of bytes to write
+ * @param offset position of the first byte in the file
+ * @return true on success, false on error
+ */
+bool pwrite_all(int fd, const char *buf, size_t size, uint64_t offset);
+
+/**
+ * @brief Writes the (node, component) associations as a CSV file
+ *
+ * The output is identical to printing the header "node_id,comp_id" followed by
+ * one "%d,%d" line per node, but lines are formatted directly into large
+ * buffers, each written with a single system call.
+ * 
+ * With more than one thread, the nodes are split into contiguous ranges.
+ * The length of the text of each range is computed beforehand, so that each
+ * thread knows where its range starts in the file (by a prefix sum) and can
+ * format and write its buffers independently with pwrite.
+ * The output file must then be a regular file.
+ *
+ * @param fd descriptor of the (already opened) output file
+ * @param comp_map the component map
+ * @param num_threads number of threads
+ * @param filter selects the nodes to write (NULL for all nodes)
+ * @return true on success, false on error
+ */
+bool write_csv(int fd, const comp_map_t &comp_map, int num_threads = 1,
+    const node_filter_t *filter = NULL);
+
+#endif
@@ -0,0 +1,51 @@
+/**
+ * @file parallel.hpp
+ * @author Matteo Loporchio
+ * @brief Minimal helpers for data-parallel loops based on std::thread
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Returns the default number of worker threads (one per hardware thread)
+ */
+inline int default_num_threads() {
+    unsigned n = std::thread::hardware_concurrency();
+    return (n == 0) ? 1 : (int) n;
+}
+
+/**
+ * @brief Splits the range [0, n) into contiguous slices and processes them in parallel
+ *
+ * The function fn is called as fn(t, begin, end) for each thread t,
+ * where [begin, end) is the slice assigned to that thread.
+ * Slices are as balanced as possible and appear in increasing order of t.
+ *
+ * @param num_threads number of threads
+ * @param n size of the range
+ * @param fn function processing a slice
+ */
+template <typename F>
+void parallel_for(int num_threads, size_t n, F fn) {
+    if (num_threads <= 1) {
+        fn(0, (size_t) 0, n);
+        return;
+    }
+    std::vector<std::thread> workers;
+    for (int t = 0; t < num_threads; t++) {
+        size_t begin = n * t / num_threads, end = n * (t + 1) / num_threads;
+        workers.push_back(std::thread(fn, t, begin, end));
+    }
+    for (size_t t = 0; t < workers.size(); t++) workers[t].join();
+}
+
+#endif
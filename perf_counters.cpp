@@ -0,0 +1,110 @@
+/**
+ * @file perf_counters.cpp
+ * @author Matteo Loporchio
+ * @brief Hardware performance counters based on perf_event_open (Linux only)
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#include "perf_counters.hpp"
+
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+const char *perf_event_names[PERF_NUM_EVENTS] = {
+    "cycles", "instructions", "cache_references", "cache_misses", "branch_misses", "dtlb_misses"
+};
+
+#ifdef __linux__
+
+/**
+ * @brief Opens a single counter
+ *
+ * @param type type of the event
+ * @param config configuration of the event
+ * @return the file descriptor of the counter, or -1 on failure
+ */
+static int perf_open_event(uint32_t type, uint64_t config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // If there are more events than hardware counters, the kernel multiplexes
+    // them: the times let perf_stop() scale the values to the whole interval.
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+bool perf_open(perf_counters_t *pc) {
+    pc->fds[PERF_CYCLES] = perf_open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    pc->fds[PERF_INSTRUCTIONS] = perf_open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    pc->fds[PERF_CACHE_REFERENCES] = perf_open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES);
+    pc->fds[PERF_CACHE_MISSES] = perf_open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    pc->fds[PERF_BRANCH_MISSES] = perf_open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    pc->fds[PERF_DTLB_MISSES] = perf_open_event(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB
+        | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+    bool any = false;
+    for (int i = 0; i < PERF_NUM_EVENTS; i++) {
+        pc->values[i] = 0;
+        if (pc->fds[i] >= 0) any = true;
+    }
+    return any;
+}
+
+void perf_start(perf_counters_t *pc) {
+    for (int i = 0; i < PERF_NUM_EVENTS; i++) {
+        if (pc->fds[i] < 0) continue;
+        ioctl(pc->fds[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(pc->fds[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+void perf_stop(perf_counters_t *pc) {
+    for (int i = 0; i < PERF_NUM_EVENTS; i++) {
+        if (pc->fds[i] < 0) continue;
+        ioctl(pc->fds[i], PERF_EVENT_IOC_DISABLE, 0);
+        // Value, time enabled and time running.
+        uint64_t data[3];
+        if (read(pc->fds[i], data, sizeof(data)) != sizeof(data)) pc->values[i] = 0;
+        else if (data[2] == 0 || data[2] >= data[1]) pc->values[i] = data[0];
+        else pc->values[i] = (uint64_t) ((double) data[0] * data[1] / data[2]);
+    }
+}
+
+void perf_close(perf_counters_t *pc) {
+    for (int i = 0; i < PERF_NUM_EVENTS; i++) {
+        if (pc->fds[i] >= 0) close(pc->fds[i]);
+        pc->fds[i] = -1;
+    }
+}
+
+#else
+
+bool perf_open(perf_counters_t *pc) {
+    for (int i = 0; i < PERF_NUM_EVENTS; i++) {
+        pc->fds[i] = -1;
+        pc->values[i] = 0;
+    }
+    return false;
+}
+
+void perf_start(perf_counters_t *pc) {}
+
+void perf_stop(perf_counters_t *pc) {}
+
+void perf_close(perf_counters_t *pc) {}
+
+#endif
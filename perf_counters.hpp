@@ -0,0 +1,82 @@
+/**
+ * @file perf_counters.hpp
+ * @author Matteo Loporchio
+ * @brief Hardware performance counters based on perf_event_open (Linux only)
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Counters that cannot be opened (e.g., because of the value of
+ * /proc/sys/kernel/perf_event_paranoid, inside containers or on other
+ * operating systems) are simply reported as unavailable.
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+#include <cstdint>
+
+/// @brief Hardware events measured by the counters
+enum perf_event_id_t {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_CACHE_REFERENCES,
+    PERF_CACHE_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_DTLB_MISSES,
+    PERF_NUM_EVENTS
+};
+
+/// @brief Names of the hardware events, indexed by perf_event_id_t
+extern const char *perf_event_names[PERF_NUM_EVENTS];
+
+/// @brief Set of hardware counters, measuring the calling thread and the threads it creates
+typedef struct {
+    int fds[PERF_NUM_EVENTS];               ///< file descriptors of the counters (-1 if unavailable)
+    uint64_t values[PERF_NUM_EVENTS];       ///< values read by the last call to perf_stop()
+} perf_counters_t;
+
+/**
+ * @brief Opens the hardware counters
+ *
+ * @param pc the counters
+ * @return true if at least one counter is available
+ */
+bool perf_open(perf_counters_t *pc);
+
+/**
+ * @brief Resets and enables the counters
+ *
+ * @param pc the counters
+ */
+void perf_start(perf_counters_t *pc);
+
+/**
+ * @brief Disables the counters and reads their values
+ *
+ * If the kernel multiplexed the counters, the values are scaled
+ * to the whole interval during which they were enabled.
+ *
+ * @param pc the counters
+ */
+void perf_stop(perf_counters_t *pc);
+
+/**
+ * @brief Tells whether a counter is available
+ *
+ * @param pc the counters
+ * @param event the event
+ */
+inline bool perf_available(const perf_counters_t *pc, int event) {
+    return pc->fds[event] >= 0;
+}
+
+/**
+ * @brief Closes the counters
+ *
+ * @param pc the counters
+ */
+void perf_close(perf_counters_t *pc);
+
+#endif
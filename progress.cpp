@@ -0,0 +1,91 @@
+/**
+ * @file progress.cpp
+ * @author Matteo Loporchio
+ * @brief Periodic progress reports of long-running loops
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#include "progress.hpp"
+#include "memory_usage.hpp"
+
+#include <cstdio>
+
+using namespace std;
+using namespace std::chrono;
+
+/**
+ * @brief Prints a single progress report
+ *
+ * @param reporter the reporter
+ */
+static void progress_report(progress_reporter_t *reporter) {
+    uint64_t bytes = __atomic_load_n(&reporter->counters->bytes, __ATOMIC_RELAXED);
+    uint64_t records = __atomic_load_n(&reporter->counters->records, __ATOMIC_RELAXED);
+    uint64_t edges = __atomic_load_n(&reporter->counters->edges, __ATOMIC_RELAXED);
+    double elapsed = duration<double>(steady_clock::now() - reporter->start).count();
+    // Rates only count the progress made since the start of the monitored loop.
+    uint64_t new_bytes = (bytes > reporter->baseline.bytes) ? bytes - reporter->baseline.bytes : 0;
+    uint64_t new_records = (records > reporter->baseline.records) ? records - reporter->baseline.records : 0;
+    double bytes_per_sec = (elapsed > 0) ? new_bytes / elapsed : 0;
+    double records_per_sec = (elapsed > 0) ? new_records / elapsed : 0;
+    // The estimate assumes that the rest of the input is consumed at the average rate so far.
+    double percent = -1, eta = -1;
+    if (reporter->total_bytes > 0) {
+        percent = 100.0 * bytes / reporter->total_bytes;
+        if (bytes_per_sec > 0 && bytes <= reporter->total_bytes) {
+            eta = (reporter->total_bytes - bytes) / bytes_per_sec;
+        }
+    }
+    rss_sample_t rss;
+    sample_rss(&rss);
+    if (reporter->status_path.empty()) {
+        fprintf(stderr, "[%.1fs] %llu bytes", elapsed, (unsigned long long) bytes);
+        if (percent >= 0) fprintf(stderr, " of %llu (%.1f%%)", (unsigned long long) reporter->total_bytes, percent);
+        fprintf(stderr, ", %llu records (%.0f/s), %llu edges, rss %llu MiB", (unsigned long long) records,
+            records_per_sec, (unsigned long long) edges, (unsigned long long) (rss.rss_bytes >> 20));
+        if (eta >= 0) fprintf(stderr, ", eta %.0fs", eta);
+        fprintf(stderr, "\n");
+        return;
+    }
+    // Write the status to a temporary file and rename it, so that readers never see a partial status.
+    string tmp_path = reporter->status_path + ".tmp";
+    FILE *status_file = fopen(tmp_path.c_str(), "w");
+    if (!status_file) return;
+    fprintf(status_file, "{\"elapsed_sec\": %.3f, \"bytes\": %llu, \"total_bytes\": %llu, \"percent\": %.2f, "
+        "\"records\": %llu, \"records_per_sec\": %.0f, \"bytes_per_sec\": %.0f, \"edges\": %llu, "
+        "\"rss_bytes\": %llu, \"eta_sec\": %.0f}\n", elapsed, (unsigned long long) bytes,
+        (unsigned long long) reporter->total_bytes, percent, (unsigned long long) records,
+        records_per_sec, bytes_per_sec, (unsigned long long) edges,
+        (unsigned long long) rss.rss_bytes, eta);
+    if (fclose(status_file) == 0) rename(tmp_path.c_str(), reporter->status_path.c_str());
+}
+
+void progress_start(progress_reporter_t *reporter, const progress_counters_t *counters,
+    const progress_counters_t *baseline, uint64_t total_bytes, long interval_ms, const char *status_path) {
+    reporter->counters = counters;
+    reporter->baseline = *baseline;
+    reporter->total_bytes = total_bytes;
+    reporter->interval = milliseconds(interval_ms);
+    reporter->status_path = status_path ? status_path : "";
+    reporter->start = steady_clock::now();
+    reporter->stop = false;
+    reporter->thread = thread([reporter]() {
+        unique_lock<mutex> lock(reporter->mutex);
+        while (!reporter->wake.wait_for(lock, reporter->interval, [reporter]() { return reporter->stop; })) {
+            progress_report(reporter);
+        }
+    });
+}
+
+void progress_stop(progress_reporter_t *reporter) {
+    {
+        lock_guard<mutex> lock(reporter->mutex);
+        reporter->stop = true;
+    }
+    reporter->wake.notify_one();
+    reporter->thread.join();
+    progress_report(reporter);
+}
@@ -0,0 +1,82 @@
+/**
+ * @file progress.hpp
+ * @author Matteo Loporchio
+ * @brief Periodic progress reports of long-running loops
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * The loop being monitored publishes its progress in a set of counters
+ * with relaxed atomic stores, which cost the same as plain stores.
+ * A reporter thread wakes up periodically, reads the counters and prints
+ * the amount of input consumed, the throughput, the current memory usage
+ * and the estimated time to completion, either to the standard error
+ * or to a status file (replaced atomically at every update).
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#ifndef PROGRESS_HPP
+#define PROGRESS_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/// @brief Counters published by the monitored loop
+typedef struct {
+    uint64_t bytes;             ///< number of input bytes consumed
+    uint64_t records;           ///< number of records (e.g., transactions) processed
+    uint64_t edges;             ///< number of edges accumulated
+} progress_counters_t;
+
+/// @brief Reporter thread
+typedef struct {
+    const progress_counters_t *counters;            ///< counters read by the reporter
+    progress_counters_t baseline;                   ///< values of the counters when the loop started
+    uint64_t total_bytes;                           ///< size of the input (0 if unknown)
+    std::chrono::milliseconds interval;             ///< time between two reports
+    std::string status_path;                        ///< status file (empty for the standard error)
+    std::chrono::steady_clock::time_point start;    ///< start of the monitored loop
+    std::thread thread;                             ///< the reporter thread
+    std::mutex mutex;                               ///< protects stop
+    std::condition_variable wake;                   ///< signaled when the reporter must stop
+    bool stop;                                      ///< true when the reporter must stop
+} progress_reporter_t;
+
+/**
+ * @brief Publishes the value of a counter (to be called by the monitored loop only)
+ *
+ * @param counter the counter
+ * @param value the new value
+ */
+inline void progress_set(uint64_t *counter, uint64_t value) {
+    __atomic_store_n(counter, value, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Starts the reporter thread
+ *
+ * The throughput and the estimated time to completion only count the progress
+ * made since the start, e.g., the input processed after resuming from a checkpoint.
+ *
+ * @param reporter the reporter
+ * @param counters counters published by the monitored loop (initially equal to the baseline)
+ * @param baseline values of the counters when the loop starts (zero, unless the loop is resumed)
+ * @param total_bytes size of the input in bytes (0 if unknown, e.g., for a pipe)
+ * @param interval_ms time between two reports in milliseconds
+ * @param status_path path of the status file, or NULL to print to the standard error
+ */
+void progress_start(progress_reporter_t *reporter, const progress_counters_t *counters,
+    const progress_counters_t *baseline, uint64_t total_bytes, long interval_ms, const char *status_path);
+
+/**
+ * @brief Stops the reporter thread, after printing a final report
+ *
+ * @param reporter the reporter
+ */
+void progress_stop(progress_reporter_t *reporter);
+
+#endif
@@ -0,0 +1,147 @@
+/**
+ * @file query_client.cpp
+ * @author Matteo Loporchio
+ * @brief Command-line client of the cluster query server
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * This program sends the node identifiers given on the command line
+ * (or, if there are none, read from the standard input, one per line)
+ * to the query server in batches, and prints one "node_id,comp_id,size"
+ * line per node, with empty fields for the nodes that do not exist.
+ * With -r, each batch is sent several times and, with -l, the average
+ * latency of a batch is printed to the standard error, e.g., to measure
+ * the server.
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vector>
+
+#include "output.hpp"
+#include "query_protocol.hpp"
+
+using namespace std;
+using namespace std::chrono;
+
+/**
+ * @brief Prints the usage message of the program
+ *
+ * @param name name of the executable
+ */
+void print_usage(const char *name) {
+    cerr << "Usage: " << name << " [options] <socket_path> [<node_id> ...]\n"
+        << "Options:\n"
+        << "  -b <batch_size>   number of queries per batch (default: 1024)\n"
+        << "  -r <repeats>      number of times each batch is sent (default: 1)\n"
+        << "  -l                print the average latency of a batch to the standard error\n"
+        << "  -q                do not print the results\n";
+}
+
+int main(int argc, char **argv) {
+    size_t batch_size = 1024;
+    long repeats = 1;
+    bool print_latency = false, quiet = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "b:lqr:")) != -1) {
+        switch (opt) {
+            case 'b':
+                batch_size = atol(optarg);
+                if (batch_size < 1 || batch_size > QUERY_MAX_BATCH) {
+                    cerr << "Error: the batch size must be between 1 and " << QUERY_MAX_BATCH << "!\n";
+                    return 1;
+                }
+                break;
+            case 'l':
+                print_latency = true;
+                break;
+            case 'q':
+                quiet = true;
+                break;
+            case 'r':
+                repeats = atol(optarg);
+                if (repeats < 1) {
+                    cerr << "Error: the number of repeats must be positive!\n";
+                    return 1;
+                }
+                break;
+            default:
+                print_usage(argv[0]);
+                return 1;
+        }
+    }
+    if (argc - optind < 1) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    // Collect the queries.
+    vector<uint32_t> nodes;
+    if (argc - optind > 1) {
+        for (int i = optind + 1; i < argc; i++) nodes.push_back(strtoul(argv[i], NULL, 10));
+    }
+    else {
+        unsigned long node;
+        while (scanf("%lu", &node) == 1) nodes.push_back(node);
+    }
+
+    // Connect to the server.
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(argv[optind]) >= sizeof(addr.sun_path)) {
+        cerr << "Error: the socket path is too long!\n";
+        return 1;
+    }
+    strcpy(addr.sun_path, argv[optind]);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (struct sockaddr *) &addr, sizeof(addr)) != 0) {
+        cerr << "Error: could not connect to the server!\n";
+        return 1;
+    }
+
+    // Send the batches and print the results.
+    vector<char> request(sizeof(uint32_t) + batch_size * sizeof(uint32_t));
+    vector<query_result_t> results(batch_size);
+    query_response_header_t header;
+    uint64_t num_batches = 0;
+    nanoseconds elapsed(0);
+    for (size_t begin = 0; begin < nodes.size(); begin += batch_size) {
+        uint32_t n = min(batch_size, nodes.size() - begin);
+        memcpy(request.data(), &n, sizeof(n));
+        memcpy(request.data() + sizeof(n), nodes.data() + begin, n * sizeof(uint32_t));
+        for (long r = 0; r < repeats; r++) {
+            auto start = steady_clock::now();
+            if (!write_all(fd, request.data(), sizeof(n) + n * sizeof(uint32_t)) ||
+                !read_all(fd, (char *) &header, sizeof(header)) || header.num_results != n ||
+                !read_all(fd, (char *) results.data(), n * sizeof(query_result_t))) {
+                cerr << "Error: the connection to the server failed!\n";
+                return 1;
+            }
+            elapsed += duration_cast<nanoseconds>(steady_clock::now() - start);
+            num_batches++;
+        }
+        if (quiet) continue;
+        for (uint32_t i = 0; i < n; i++) {
+            if (results[i].comp_id == QUERY_NOT_FOUND) printf("%u,,\n", nodes[begin + i]);
+            else printf("%u,%llu,%llu\n", nodes[begin + i], (unsigned long long) results[i].comp_id,
+                (unsigned long long) results[i].size);
+        }
+    }
+    close(fd);
+
+    // Print the number of batches, the number of queries per batch and the average latency in nanoseconds.
+    if (print_latency && num_batches > 0) {
+        cerr << num_batches << '\t' << batch_size << '\t' << elapsed.count() / num_batches << '\n';
+    }
+    return 0;
+}
@@ -0,0 +1,43 @@
+/**
+ * @file query_protocol.hpp
+ * @author Matteo Loporchio
+ * @brief Binary protocol of the cluster query server
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Clients connect to the Unix domain socket of the server and send batches
+ * of queries over the same connection. Each batch is a 32-bit count n
+ * (at most QUERY_MAX_BATCH) followed by n 32-bit node identifiers.
+ * The server answers with a query_response_header_t followed by n
+ * query_result_t records, in the order of the queries. All integers are
+ * in the native byte order of the machine, since client and server
+ * always run on the same host. Batches that are too large close the connection.
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#ifndef QUERY_PROTOCOL_HPP
+#define QUERY_PROTOCOL_HPP
+
+#include <cstdint>
+
+/// @brief Maximum number of queries in a batch
+#define QUERY_MAX_BATCH (1 << 16)
+
+/// @brief Component of the nodes that do not exist in the snapshot
+#define QUERY_NOT_FOUND UINT64_MAX
+
+/// @brief Header of the response to a batch
+typedef struct {
+    uint32_t num_results;       ///< number of results (equal to the number of queries)
+    uint32_t reserved;          ///< always zero
+    uint64_t generation;        ///< number of the snapshot that answered the batch (1 for the first one)
+} query_response_header_t;
+
+/// @brief Result of a query
+typedef struct {
+    uint64_t comp_id;           ///< component of the node (QUERY_NOT_FOUND if the node does not exist)
+    uint64_t size;              ///< number of nodes of the component (0 if the node does not exist)
+} query_result_t;
+
+#endif
@@ -0,0 +1,313 @@
+/**
+ * @file query_server.cpp
+ * @author Matteo Loporchio
+ * @brief Low-latency server answering queries on the clusters of a component map
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * This program maps a binary component map (see comp_map_file.hpp) in memory
+ * and answers the question "which cluster is address X in, and how large is it"
+ * over a Unix domain socket, with the binary protocol of query_protocol.hpp.
+ * Queries are batched: the entries of the nodes of a batch are prefetched
+ * a few queries ahead, and the sizes of their components are prefetched
+ * before they are read, so the latencies of the cache (or page) misses
+ * of a batch overlap.
+ *
+ * The size of each component is counted in parallel when a map is loaded
+ * and kept in a table next to the mapping. Each connection is served by its
+ * own thread, which takes a reference to the current snapshot for each batch.
+ *
+ * The server checks periodically whether the map file has been replaced
+ * (e.g., by the streamer program or by a new run of the analyzer or of the
+ * incremental program, all of which write binary maps to a temporary file
+ * and rename it over the previous one, so the mapped file is never modified
+ * in place) and, if so, loads the new snapshot and swaps it in atomically;
+ * SIGHUP forces a reload. The previous snapshot is unmapped as soon as the
+ * last batch using it has been answered.
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "comp_map_file.hpp"
+#include "output.hpp"
+#include "parallel.hpp"
+#include "query_protocol.hpp"
+
+using namespace std;
+using namespace std::chrono;
+
+/// @brief Maximum number of pending connections
+#define QUERY_BACKLOG 64
+
+/// @brief Maximum time in milliseconds before a stop request is noticed
+#define QUERY_STOP_CHECK_MS 100
+
+/// @brief Number of queries whose entries are prefetched ahead of the one being answered
+#define QUERY_PREFETCH_DISTANCE 16
+
+/// @brief Component map loaded by the server
+typedef struct {
+    comp_map_view_t view;           ///< the mapped component map
+    vector<uint32_t> sizes;         ///< size of each component
+    uint64_t generation;            ///< number of the snapshot
+    struct stat file_stat;          ///< status of the file when it was loaded
+} snapshot_t;
+
+/// @brief Set by the signal handler when the server must stop
+static volatile sig_atomic_t stop_requested = 0;
+
+/// @brief Set by the signal handler when the map must be reloaded
+static volatile sig_atomic_t reload_requested = 0;
+
+/**
+ * @brief Handles the signals of the server
+ *
+ * @param signum the signal: SIGHUP requests a reload, the others a stop
+ */
+static void handle_signal(int signum) {
+    if (signum == SIGHUP) reload_requested = 1;
+    else stop_requested = 1;
+}
+
+/**
+ * @brief Prints the usage message of the program
+ *
+ * @param name name of the executable
+ */
+void print_usage(const char *name) {
+    cerr << "Usage: " << name << " [options] <map_file> <socket_path>\n"
+        << "Options:\n"
+        << "  -r <ms>           interval between two checks for a new map file (default: 1000, 0 to disable)\n"
+        << "  -t <num_threads>  number of threads counting the component sizes (default: number of hardware threads)\n";
+}
+
+/**
+ * @brief Maps a component map file and counts the size of each component
+ *
+ * @param path path of the file
+ * @param num_threads number of threads
+ * @param generation number of the snapshot
+ * @return the snapshot, or an empty pointer if the file is not a valid component map
+ */
+shared_ptr<snapshot_t> load_snapshot(const char *path, int num_threads, uint64_t generation) {
+    shared_ptr<snapshot_t> snapshot(new snapshot_t, [](snapshot_t *s) {
+        if (s->view.base) unmap_comp_map_file(&s->view);
+        delete s;
+    });
+    snapshot->view.base = NULL;
+    snapshot->generation = generation;
+    // The status is taken before mapping, so a replacement during the load is detected later.
+    if (stat(path, &snapshot->file_stat) != 0 || !map_comp_map_file(path, &snapshot->view)) {
+        return shared_ptr<snapshot_t>();
+    }
+    const comp_map_view_t *view = &snapshot->view;
+    uint64_t num_nodes = view->header->num_nodes;
+    if (num_nodes > UINT32_MAX) return shared_ptr<snapshot_t>();
+    // Whatever the numbering, each component is smaller than the number of nodes.
+    vector<uint64_t> max_comp(num_threads, 0);
+    parallel_for(num_threads, num_nodes, [&](int t, size_t begin, size_t end) {
+        uint64_t m = 0;
+        for (size_t i = begin; i < end; i++) m = max(m, comp_map_entry(view, i));
+        max_comp[t] = m;
+    });
+    uint64_t num_comps = 0;
+    for (int t = 0; t < num_threads; t++) num_comps = max(num_comps, max_comp[t] + 1);
+    if (num_nodes > 0 && num_comps > num_nodes) return shared_ptr<snapshot_t>();
+    snapshot->sizes.assign(num_nodes > 0 ? num_comps : 0, 0);
+    uint32_t *sizes = snapshot->sizes.data();
+    parallel_for(num_threads, num_nodes, [&](int t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) __atomic_fetch_add(&sizes[comp_map_entry(view, i)], 1, __ATOMIC_RELAXED);
+    });
+    return snapshot;
+}
+
+/**
+ * @brief Answers a batch of queries
+ *
+ * @param snapshot the snapshot
+ * @param nodes the nodes
+ * @param num_queries number of queries
+ * @param results receives the results
+ */
+void answer_batch(const snapshot_t *snapshot, const uint32_t *nodes, uint32_t num_queries, query_result_t *results) {
+    const comp_map_view_t *view = &snapshot->view;
+    const uint32_t *sizes = snapshot->sizes.data();
+    uint64_t num_nodes = view->header->num_nodes;
+    uint32_t width = view->header->width;
+    // First, find the component of each node, prefetching the entries of the following nodes.
+    for (uint32_t i = 0; i < num_queries; i++) {
+        if (i + QUERY_PREFETCH_DISTANCE < num_queries && nodes[i + QUERY_PREFETCH_DISTANCE] < num_nodes) {
+            __builtin_prefetch((const char *) view->entries + (uint64_t) nodes[i + QUERY_PREFETCH_DISTANCE] * width);
+        }
+        if (nodes[i] < num_nodes) {
+            results[i].comp_id = comp_map_entry(view, nodes[i]);
+            __builtin_prefetch(&sizes[results[i].comp_id]);
+        }
+        else results[i].comp_id = QUERY_NOT_FOUND;
+    }
+    // Then, read the sizes of the components, which have been prefetched in the meantime.
+    for (uint32_t i = 0; i < num_queries; i++) {
+        results[i].size = (results[i].comp_id != QUERY_NOT_FOUND) ? sizes[results[i].comp_id] : 0;
+    }
+}
+
+/**
+ * @brief Serves the batches of a connection until the client closes it
+ *
+ * @param fd the connection
+ * @param current the current snapshot
+ */
+void serve_client(int fd, const shared_ptr<snapshot_t> *current) {
+    vector<uint32_t> nodes;
+    vector<char> response;
+    uint32_t num_queries;
+    while (read_all(fd, (char *) &num_queries, sizeof(num_queries)) && num_queries <= QUERY_MAX_BATCH) {
+        nodes.resize(num_queries);
+        if (!read_all(fd, (char *) nodes.data(), num_queries * sizeof(uint32_t))) break;
+        // Keep the snapshot alive while the batch is answered, even if a reload replaces it.
+        shared_ptr<snapshot_t> snapshot = atomic_load(current);
+        response.resize(sizeof(query_response_header_t) + num_queries * sizeof(query_result_t));
+        query_response_header_t *header = (query_response_header_t *) response.data();
+        header->num_results = num_queries;
+        header->reserved = 0;
+        header->generation = snapshot->generation;
+        answer_batch(snapshot.get(), nodes.data(), num_queries,
+            (query_result_t *) (response.data() + sizeof(query_response_header_t)));
+        snapshot.reset();
+        if (!write_all(fd, response.data(), response.size())) break;
+    }
+    close(fd);
+}
+
+int main(int argc, char **argv) {
+    long reload_ms = 1000;
+    int num_threads = default_num_threads();
+    int opt;
+    while ((opt = getopt(argc, argv, "r:t:")) != -1) {
+        switch (opt) {
+            case 'r':
+                reload_ms = atol(optarg);
+                if (reload_ms < 0) {
+                    cerr << "Error: the reload interval must be non-negative!\n";
+                    return 1;
+                }
+                break;
+            case 't':
+                num_threads = atoi(optarg);
+                if (num_threads < 1) {
+                    cerr << "Error: the number of threads must be positive!\n";
+                    return 1;
+                }
+                break;
+            default:
+                print_usage(argv[0]);
+                return 1;
+        }
+    }
+    if (argc - optind < 2) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    const char *map_path = argv[optind];
+    const char *socket_path = argv[optind + 1];
+
+    // Load the first snapshot. The pointer to the current snapshot is never
+    // destroyed, since detached client threads may still use it at exit.
+    uint64_t generation = 1;
+    shared_ptr<snapshot_t> *current = new shared_ptr<snapshot_t>(load_snapshot(map_path, num_threads, generation));
+    if (!*current) {
+        cerr << "Error: could not load the component map!\n";
+        return 1;
+    }
+    cerr << "Loaded snapshot " << generation << " with " << (*current)->view.header->num_nodes << " nodes\n";
+
+    // Listen on the socket, replacing a stale one.
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(socket_path) >= sizeof(addr.sun_path)) {
+        cerr << "Error: the socket path is too long!\n";
+        return 1;
+    }
+    strcpy(addr.sun_path, socket_path);
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(socket_path);
+    if (listen_fd < 0 || bind(listen_fd, (struct sockaddr *) &addr, sizeof(addr)) != 0 ||
+        listen(listen_fd, QUERY_BACKLOG) != 0) {
+        cerr << "Error: could not listen on the socket!\n";
+        return 1;
+    }
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = handle_signal;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    sigaction(SIGHUP, &action, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    // Check periodically whether the map file has been replaced, and swap in the new snapshot.
+    thread watcher([&]() {
+        struct stat watched = (*current)->file_stat;
+        auto last_check = steady_clock::now();
+        while (!stop_requested) {
+            this_thread::sleep_for(milliseconds(QUERY_STOP_CHECK_MS));
+            if (!reload_requested && (reload_ms == 0 || steady_clock::now() - last_check < milliseconds(reload_ms))) {
+                continue;
+            }
+            last_check = steady_clock::now();
+            struct stat st;
+            if (stat(map_path, &st) != 0) continue;
+            bool changed = (st.st_ino != watched.st_ino || st.st_mtime != watched.st_mtime ||
+                st.st_size != watched.st_size);
+            if (!changed && !reload_requested) continue;
+            reload_requested = 0;
+            // If the new file is invalid, it is not retried until it changes again.
+            watched = st;
+            shared_ptr<snapshot_t> snapshot = load_snapshot(map_path, num_threads, generation + 1);
+            if (!snapshot) {
+                cerr << "Warning: could not load the new component map, keeping the previous one!\n";
+                continue;
+            }
+            watched = snapshot->file_stat;
+            generation++;
+            atomic_store(current, snapshot);
+            cerr << "Loaded snapshot " << generation << " with " << snapshot->view.header->num_nodes << " nodes\n";
+        }
+    });
+
+    // Serve each connection in its own thread. The socket is polled with a timeout,
+    // so that a stop request is noticed even if the signal is handled by another thread.
+    while (!stop_requested) {
+        struct pollfd pfd = {listen_fd, POLLIN, 0};
+        if (poll(&pfd, 1, QUERY_STOP_CHECK_MS) <= 0) continue;
+        int fd = accept(listen_fd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR || errno == EAGAIN) continue;
+            cerr << "Error: could not accept a connection!\n";
+            break;
+        }
+        thread(serve_client, fd, current).detach();
+    }
+    close(listen_fd);
+    unlink(socket_path);
+    watcher.join();
+    return 0;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file report.cpp
+ * @author Matteo Loporchio
+ * @brief Per-phase execution reports of the builder and of the analyzer
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#include "report.hpp"
+
+#include <algorithm>
+#include <ctime>
+
+using namespace std;
+using namespace std::chrono;
+
+/**
+ * @brief Returns the CPU time consumed so far by all threads of the process, in nanoseconds
+ */
+static uint64_t process_cpu_ns() {
+    struct timespec ts;
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) != 0) return 0;
+    return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+void report_init(run_report_t *report, const char *program) {
+    report->program = program;
+    report->phases.clear();
+    report->start = report->phase_start = steady_clock::now();
+    report->cpu_start = report->phase_cpu_start = process_cpu_ns();
+    report->phase_name = NULL;
+    report->phase_peaks = true;
+    report->peak_rss_bytes = 0;
+    report->use_counters = false;
+}
+
+bool report_enable_counters(run_report_t *report) {
+    report->use_counters = perf_open(&report->perf);
+    if (!report->use_counters) perf_close(&report->perf);
+    return report->use_counters;
+}
+
+void phase_begin(run_report_t *report, const char *name) {
+    report->phase_name = name;
+    // If the peak cannot be reset, the high-water mark of each phase
+    // is the one of the whole execution up to the end of the phase.
+    if (report->phase_peaks) report->phase_peaks = reset_peak_rss();
+    reset_largest_allocation();
+    get_alloc_stats(&report->phase_allocs);
+    report->phase_start = steady_clock::now();
+    report->phase_cpu_start = process_cpu_ns();
+    if (report->use_counters) perf_start(&report->perf);
+}
+
+void phase_end(run_report_t *report, uint64_t bytes, uint64_t records) {
+    phase_stats_t phase;
+    if (report->use_counters) perf_stop(&report->perf);
+    phase.name = report->phase_name;
+    phase.wall_ns = duration_cast<nanoseconds>(steady_clock::now() - report->phase_start).count();
+    phase.cpu_ns = process_cpu_ns() - report->phase_cpu_start;
+    phase.bytes = bytes;
+    phase.records = records;
+    sample_rss(&phase.rss);
+    get_alloc_stats(&phase.allocs);
+    phase.allocs.count -= report->phase_allocs.count;
+    phase.allocs.bytes -= report->phase_allocs.bytes;
+    for (int i = 0; i < PERF_NUM_EVENTS; i++) phase.counters[i] = report->use_counters ? report->perf.values[i] : 0;
+    if (phase.rss.peak_rss_bytes > report->peak_rss_bytes) report->peak_rss_bytes = phase.rss.peak_rss_bytes;
+    report->phases.push_back(phase);
+}
+
+/**
+ * @brief Returns the number of items processed per second
+ *
+ * @param count number of items
+ * @param ns elapsed time in nanoseconds
+ */
+static double per_second(uint64_t count, uint64_t ns) {
+    return (ns == 0) ? 0 : count * 1e9 / ns;
+}
+
+/**
+ * @brief Writes the hardware counters of a phase, with the derived ratios (null if unavailable)
+ *
+ * @param output_file pointer to the output file
+ * @param report the report
+ * @param phase the phase
+ */
+static void write_counters(FILE *output_file, const run_report_t *report, const phase_stats_t &phase) {
+    const uint64_t *c = phase.counters;
+    const perf_counters_t *pc = &report->perf;
+    fprintf(output_file, ", \"counters\": {");
+    for (int i = 0; i < PERF_NUM_EVENTS; i++) {
+        fprintf(output_file, "%s\"%s\": ", (i == 0) ? "" : ", ", perf_event_names[i]);
+        if (perf_available(pc, i)) fprintf(output_file, "%llu", (unsigned long long) c[i]);
+        else fprintf(output_file, "null");
+    }
+    // Ratios: instructions per cycle, cache misses per reference and misses per record.
+    fprintf(output_file, ", \"ipc\": ");
+    if (perf_available(pc, PERF_CYCLES) && perf_available(pc, PERF_INSTRUCTIONS) && c[PERF_CYCLES] > 0) {
+        fprintf(output_file, "%.3f", (double) c[PERF_INSTRUCTIONS] / c[PERF_CYCLES]);
+    }
+    else fprintf(output_file, "null");
+    fprintf(output_file, ", \"cache_miss_rate\": ");
+    if (perf_available(pc, PERF_CACHE_MISSES) && perf_available(pc, PERF_CACHE_REFERENCES)
+        && c[PERF_CACHE_REFERENCES] > 0) {
+        fprintf(output_file, "%.4f", (double) c[PERF_CACHE_MISSES] / c[PERF_CACHE_REFERENCES]);
+    }
+    else fprintf(output_file, "null");
+    const int per_record[] = {PERF_CACHE_MISSES, PERF_BRANCH_MISSES, PERF_DTLB_MISSES};
+    for (int i : per_record) {
+        fprintf(output_file, ", \"%s_per_record\": ", perf_event_names[i]);
+        if (perf_available(pc, i) && phase.records > 0) fprintf(output_file, "%.4f", (double) c[i] / phase.records);
+        else fprintf(output_file, "null");
+    }
+    fprintf(output_file, "}");
+}
+
+void write_report(FILE *output_file, const run_report_t *report) {
+    uint64_t wall_ns = duration_cast<nanoseconds>(steady_clock::now() - report->start).count();
+    uint64_t cpu_ns = process_cpu_ns() - report->cpu_start;
+    // The peak of the whole execution is the largest one observed, since the
+    // peak is reset at each phase. The value reported by getrusage is only used
+    // as a fallback, since on Linux it includes the memory of the parent
+    // process before the program was executed.
+    rss_sample_t rss;
+    sample_rss(&rss);
+    uint64_t peak_rss = max(rss.peak_rss_bytes, report->peak_rss_bytes);
+    if (peak_rss == 0) peak_rss = max_rss_bytes();
+    alloc_stats_t allocs;
+    get_alloc_stats(&allocs);
+    uint64_t largest = 0;
+    for (size_t i = 0; i < report->phases.size(); i++) largest = max(largest, report->phases[i].allocs.largest);
+    fprintf(output_file, "{\n");
+    fprintf(output_file, "  \"program\": \"%s\",\n", report->program);
+    fprintf(output_file, "  \"phases\": [");
+    for (size_t i = 0; i < report->phases.size(); i++) {
+        const phase_stats_t &p = report->phases[i];
+        fprintf(output_file, "%s\n    {\"name\": \"%s\", \"wall_ns\": %llu, \"cpu_ns\": %llu, "
+            "\"bytes\": %llu, \"records\": %llu, \"bytes_per_sec\": %.0f, \"records_per_sec\": %.0f, "
+            "\"rss_bytes\": %llu, \"peak_rss_bytes\": %llu, "
+            "\"large_allocs\": %llu, \"large_alloc_bytes\": %llu, \"largest_alloc_bytes\": %llu",
+            (i == 0) ? "" : ",", p.name, (unsigned long long) p.wall_ns, (unsigned long long) p.cpu_ns,
+            (unsigned long long) p.bytes, (unsigned long long) p.records,
+            per_second(p.bytes, p.wall_ns), per_second(p.records, p.wall_ns),
+            (unsigned long long) p.rss.rss_bytes, (unsigned long long) p.rss.peak_rss_bytes,
+            (unsigned long long) p.allocs.count, (unsigned long long) p.allocs.bytes,
+            (unsigned long long) p.allocs.largest);
+        if (report->use_counters) write_counters(output_file, report, p);
+        fprintf(output_file, "}");
+    }
+    fprintf(output_file, "%s],\n", report->phases.empty() ? "" : "\n  ");
+    fprintf(output_file, "  \"phase_peaks\": %s,\n", report->phase_peaks ? "true" : "false");
+    fprintf(output_file, "  \"counters\": %s,\n", report->use_counters ? "true" : "false");
+    fprintf(output_file, "  \"total\": {\"wall_ns\": %llu, \"cpu_ns\": %llu, \"peak_rss_bytes\": %llu, "
+        "\"large_allocs\": %llu, \"large_alloc_bytes\": %llu, \"largest_alloc_bytes\": %llu}\n",
+        (unsigned long long) wall_ns, (unsigned long long) cpu_ns, (unsigned long long) peak_rss,
+        (unsigned long long) allocs.count, (unsigned long long) allocs.bytes, (unsigned long long) largest);
+    fprintf(output_file, "}\n");
+}
@@ -0,0 +1,105 @@
+/**
+ * @file report.hpp
+ * @author Matteo Loporchio
+ * @brief Per-phase execution reports of the builder and of the analyzer
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * A report splits the execution of a program into consecutive phases
+ * (e.g., parsing, sorting, writing) and records, for each phase, its wall
+ * time (from a monotonic clock), the CPU time of the process (all threads)
+ * and the number of bytes and records it processed, together with the
+ * resident memory (at the end of the phase and its high-water mark during
+ * the phase) and the large allocations made by the phase (see memory_usage.hpp).
+ * If enabled, the hardware counters (see perf_counters.hpp) of each phase
+ * are also recorded, e.g., to tell whether a phase is bound by the latency
+ * or by the bandwidth of the memory.
+ * The report can be written as a JSON document, including the derived throughputs.
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#ifndef REPORT_HPP
+#define REPORT_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "memory_usage.hpp"
+#include "perf_counters.hpp"
+
+/// @brief Statistics of a single phase
+typedef struct {
+    const char *name;       ///< name of the phase
+    uint64_t wall_ns;       ///< wall time in nanoseconds
+    uint64_t cpu_ns;        ///< CPU time of the process in nanoseconds
+    uint64_t bytes;         ///< number of bytes processed
+    uint64_t records;       ///< number of records processed
+    rss_sample_t rss;       ///< resident set size at the end of the phase and its peak during the phase
+    alloc_stats_t allocs;   ///< large allocations made during the phase
+    uint64_t counters[PERF_NUM_EVENTS];     ///< values of the hardware counters during the phase
+} phase_stats_t;
+
+/// @brief Execution report of a program
+typedef struct {
+    const char *program;                                ///< name of the program
+    std::vector<phase_stats_t> phases;                  ///< completed phases
+    std::chrono::steady_clock::time_point start;        ///< start of the execution
+    std::chrono::steady_clock::time_point phase_start;  ///< start of the current phase
+    uint64_t cpu_start;                                 ///< CPU time at the start of the execution
+    uint64_t phase_cpu_start;                           ///< CPU time at the start of the current phase
+    const char *phase_name;                             ///< name of the current phase
+    alloc_stats_t phase_allocs;                         ///< allocation statistics at the start of the current phase
+    bool phase_peaks;                                   ///< true if the peak memory is reset at the start of each phase
+    uint64_t peak_rss_bytes;                            ///< peak resident set size observed so far
+    bool use_counters;                                  ///< true if the hardware counters are enabled
+    perf_counters_t perf;                               ///< hardware counters (if enabled)
+} run_report_t;
+
+/**
+ * @brief Starts a report
+ *
+ * @param report the report
+ * @param program name of the program
+ */
+void report_init(run_report_t *report, const char *program);
+
+/**
+ * @brief Enables the hardware counters of the report
+ *
+ * Must be called before starting any thread, since the counters
+ * only measure the threads created after they are opened.
+ *
+ * @param report the report
+ * @return true if at least one counter is available, false otherwise
+ */
+bool report_enable_counters(run_report_t *report);
+
+/**
+ * @brief Starts a new phase
+ *
+ * @param report the report
+ * @param name name of the phase (must remain valid until the report is written)
+ */
+void phase_begin(run_report_t *report, const char *name);
+
+/**
+ * @brief Ends the current phase
+ *
+ * @param report the report
+ * @param bytes number of bytes processed by the phase
+ * @param records number of records processed by the phase
+ */
+void phase_end(run_report_t *report, uint64_t bytes, uint64_t records);
+
+/**
+ * @brief Writes a report as a JSON document
+ *
+ * @param output_file pointer to the (already opened) output file
+ * @param report the report
+ */
+void write_report(FILE *output_file, const run_report_t *report);
+
+#endif
@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+#
+#	File:	scaling.py
+#	Author:	Matteo Loporchio
+#
+#	End-to-end scaling benchmark of the builder and of the analyzer.
+#
+#	For each input size, the script generates a synthetic chain of transactions
+#	(with the generator program), builds the auxiliary graph and computes its
+#	connected components with every combination of engine and number of threads.
+#	For each run, it records the wall time, the peak resident memory and the
+#	SHA-256 checksum of the output file in a JSON results file. The analyzer
+#	writes canonical (rank) component identifiers, so all its runs on the same
+#	input must produce the same checksum.
+#
+#	If a baseline results file is given, the script compares each run with the
+#	corresponding baseline run and reports a regression if the wall time or the
+#	peak memory grew by more than the threshold, or if the checksum changed.
+#	The exit status is 1 if any regression is found.
+#
+#	Example:
+#		make all generator
+#		./scaling.py --sizes 10M,100M --threads 1,8 --output results.json
+#		./scaling.py --sizes 10M,100M --threads 1,8 --baseline results.json
+#
+
+import argparse
+import hashlib
+import json
+import os
+import platform
+import subprocess
+import sys
+import time
+
+SIZE_SUFFIXES = {'K': 10**3, 'M': 10**6, 'B': 10**9, 'G': 10**9}
+
+def parse_size(text):
+    """Parses a number of transactions such as 10M or 1B."""
+    text = text.strip().upper()
+    if text and text[-1] in SIZE_SUFFIXES:
+        return int(float(text[:-1]) * SIZE_SUFFIXES[text[-1]])
+    return int(text)
+
+def sha256_file(path):
+    """Returns the SHA-256 checksum of a file."""
+    digest = hashlib.sha256()
+    with open(path, 'rb') as f:
+        for chunk in iter(lambda: f.read(1 << 22), b''):
+            digest.update(chunk)
+    return digest.hexdigest()
+
+def run(command):
+    """Runs a command and returns its standard output and wall time, exiting on failure."""
+    start = time.monotonic()
+    process = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+    wall = time.monotonic() - start
+    if process.returncode != 0:
+        sys.exit('Error: command %s failed:\n%s' % (' '.join(command), process.stderr.decode()))
+    return process.stdout.decode(), wall
+
+def run_reported(command, report_path):
+    """Runs a program with an execution report (-j) and returns its output, wall time and report.
+
+    The peak memory is taken from the report rather than from the resource usage
+    of the child, since on Linux the latter includes the memory of the (forked)
+    script before the program is executed.
+    """
+    out, wall = run(command[:1] + ['-j', report_path] + command[1:])
+    with open(report_path) as f:
+        report = json.load(f)
+    os.remove(report_path)
+    return out, wall, report
+
+def run_key(result):
+    """Returns the key identifying a run across results files."""
+    return (result['stage'], result['num_tx'], result.get('engine', ''), result.get('threads', 0))
+
+def run_pipeline(args):
+    """Runs all the configurations and returns the list of results."""
+    results = []
+    os.makedirs(args.work_dir, exist_ok=True)
+    for size in args.sizes:
+        tx_path = os.path.join(args.work_dir, 'tx_%d.txt' % size)
+        graph_path = os.path.join(args.work_dir, 'graph_%d.bin' % size)
+        if not os.path.exists(tx_path):
+            run([os.path.join(args.bin_dir, 'generator'), '-s', str(args.seed), str(size), tx_path])
+        report_path = os.path.join(args.work_dir, 'report.json')
+        out, wall, report = run_reported([os.path.join(args.bin_dir, 'builder'), tx_path, graph_path], report_path)
+        peak = report['total']['peak_rss_bytes']
+        num_nodes, num_edges = out.split()[:2]
+        results.append({'stage': 'builder', 'num_tx': size, 'input_bytes': os.path.getsize(tx_path),
+            'num_nodes': int(num_nodes), 'num_edges': int(num_edges), 'wall_sec': wall,
+            'peak_rss_bytes': peak, 'checksum': sha256_file(graph_path), 'phases': report['phases']})
+        print('builder\t%d\t\t\t%.3f\t%d' % (size, wall, peak), file=sys.stderr)
+        if not args.keep_inputs:
+            os.remove(tx_path)
+        for engine in args.engines:
+            for threads in args.threads:
+                map_path = os.path.join(args.work_dir, 'map_%d.bin' % size)
+                out, wall, report = run_reported([os.path.join(args.bin_dir, 'clustering'), '-e', engine,
+                    '-t', str(threads), '-c', 'rank', '-f', 'bin', graph_path, map_path], report_path)
+                peak = report['total']['peak_rss_bytes']
+                results.append({'stage': 'clustering', 'num_tx': size, 'engine': engine, 'threads': threads,
+                    'num_components': int(out.split()[2]), 'wall_sec': wall, 'peak_rss_bytes': peak,
+                    'checksum': sha256_file(map_path), 'phases': report['phases']})
+                print('clustering\t%d\t%s\t%d\t%.3f\t%d' % (size, engine, threads, wall, peak), file=sys.stderr)
+                os.remove(map_path)
+        os.remove(graph_path)
+    return results
+
+def check_consistency(results):
+    """Returns the inputs on which the analyzer runs produced different outputs."""
+    checksums = {}
+    for r in results:
+        if r['stage'] == 'clustering':
+            checksums.setdefault(r['num_tx'], set()).add(r['checksum'])
+    return [size for size, values in checksums.items() if len(values) > 1]
+
+def compare(results, baseline, threshold):
+    """Compares the results with a baseline and returns the list of regressions."""
+    regressions = []
+    base_runs = {run_key(r): r for r in baseline['runs']}
+    for r in results:
+        b = base_runs.get(run_key(r))
+        if b is None:
+            continue
+        name = ' '.join(str(x) for x in run_key(r) if x != '')
+        for metric in ['wall_sec', 'peak_rss_bytes']:
+            if b[metric] > 0 and r[metric] > b[metric] * (1 + threshold):
+                regressions.append('%s: %s grew from %g to %g (+%.1f%%)' % (name, metric, b[metric], r[metric],
+                    100 * (r[metric] / b[metric] - 1)))
+        if r['checksum'] != b['checksum']:
+            regressions.append('%s: checksum changed' % name)
+    return regressions
+
+def main():
+    parser = argparse.ArgumentParser(description='End-to-end scaling benchmark of builder and clustering.')
+    parser.add_argument('--sizes', default='10M,100M,1B',
+        help='comma-separated numbers of transactions (default: 10M,100M,1B)')
+    parser.add_argument('--engines', default='uf,par,afforest,ext',
+        help='comma-separated clustering engines (default: uf,par,afforest,ext)')
+    parser.add_argument('--threads', default=str(os.cpu_count() or 1),
+        help='comma-separated thread counts (default: number of CPUs)')
+    parser.add_argument('--seed', type=int, default=1, help='seed of the generator (default: 1)')
+    parser.add_argument('--bin-dir', default='.', help='directory of the executables (default: .)')
+    parser.add_argument('--work-dir', default='scaling_work', help='directory of the temporary files')
+    parser.add_argument('--keep-inputs', action='store_true', help='keep the generated transaction files')
+    parser.add_argument('--output', default='scaling_results.json', help='results file (default: scaling_results.json)')
+    parser.add_argument('--baseline', help='results file of a previous run to compare with')
+    parser.add_argument('--threshold', type=float, default=0.1,
+        help='relative growth of time or memory reported as a regression (default: 0.1)')
+    args = parser.parse_args()
+    args.sizes = [parse_size(s) for s in args.sizes.split(',')]
+    args.engines = args.engines.split(',')
+    args.threads = [int(t) for t in args.threads.split(',')]
+
+    results = run_pipeline(args)
+    document = {'machine': {'hostname': platform.node(), 'system': platform.platform(),
+        'cpus': os.cpu_count()}, 'time': time.strftime('%Y-%m-%dT%H:%M:%S'), 'seed': args.seed, 'runs': results}
+    with open(args.output, 'w') as f:
+        json.dump(document, f, indent=2)
+
+    failed = False
+    for size in check_consistency(results):
+        print('Error: the engines produced different components for %d transactions!' % size, file=sys.stderr)
+        failed = True
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        regressions = compare(results, baseline, args.threshold)
+        for r in regressions:
+            print('Regression: ' + r, file=sys.stderr)
+        if not regressions:
+            print('No regressions with respect to %s.' % args.baseline, file=sys.stderr)
+        failed = failed or bool(regressions)
+    return 1 if failed else 0
+
+if __name__ == '__main__':
+    sys.exit(main())
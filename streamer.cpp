@@ -0,0 +1,344 @@
+/**
+ * @file streamer.cpp
+ * @author Matteo Loporchio
+ * @brief Continuous address clustering of a stream of transactions
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * This program reads transaction lines continuously from the standard input
+ * or from a named pipe (e.g., fed by a node as new blocks arrive), merges the
+ * input addresses of each transaction in an in-memory union-find forest as
+ * soon as its line is complete, and periodically publishes a snapshot of the
+ * clustering. Snapshots are written to a temporary file that is then renamed
+ * over the previous one, so readers (e.g., a program mapping the binary
+ * component map) always see a complete snapshot.
+ *
+ * The latency between the arrival of a transaction and the publication
+ * of a snapshot reflecting it is bounded by the interval given with -l
+ * (plus the time needed to write the snapshot): the first change after
+ * a snapshot sets the deadline of the next one, and the input is polled
+ * with a timeout, so the deadline is met even if no further line arrives.
+ * No snapshot is written while nothing changes.
+ *
+ * With -s, the forest starts from a state file of the incremental program
+ * (see uf_state.hpp) and is saved back, so the stream can be resumed after
+ * a restart (the input offset of the state is left unchanged, since a stream
+ * cannot be sought). Since the state holds the whole forest and is synced
+ * to disk, it is not saved at every snapshot, which would make the latency
+ * depend on its size, but at the first snapshot after the interval given
+ * with -S has elapsed, and when the program exits. After a crash, the state
+ * thus misses at most the transactions of the last interval (plus the
+ * snapshot latency), which must be fed again: merging a transaction twice
+ * does not change the clustering. When the input ends, a final snapshot is
+ * written; with -k, a named pipe is then reopened and waits for a new writer.
+ * SIGINT and SIGTERM also write a final snapshot before exiting.
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <poll.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "comp_map_file.hpp"
+#include "components.hpp"
+#include "output.hpp"
+#include "parallel.hpp"
+#include "transactions.hpp"
+#include "uf_state.hpp"
+
+using namespace std;
+using namespace std::chrono;
+
+/// @brief Size of each read from the input
+#define STREAM_READ_SIZE (1 << 16)
+
+/// @brief Formats of the snapshots
+enum output_format_t {
+    FORMAT_CSV,         ///< one "node_id,comp_id" line per node
+    FORMAT_BIN          ///< binary component map (see comp_map_file.hpp)
+};
+
+/// @brief Set by the signal handler when the program must stop
+static volatile sig_atomic_t stop_requested = 0;
+
+/**
+ * @brief Handles SIGINT and SIGTERM by requesting a final snapshot
+ *
+ * @param signum the signal
+ */
+static void handle_stop(int signum) {
+    stop_requested = 1;
+}
+
+/**
+ * @brief Prints the usage message of the program
+ *
+ * @param name name of the executable
+ */
+void print_usage(const char *name) {
+    cerr << "Usage: " << name << " [options] <snapshot_file>\n"
+        << "Options:\n"
+        << "  -i <input>        read the transactions from a file or named pipe (default: standard input)\n"
+        << "  -k                reopen the named pipe when its writers close it, instead of exiting\n"
+        << "  -l <ms>           maximum delay between a transaction and the snapshot reflecting it (default: 1000)\n"
+        << "  -s <state_file>   start from a union-find state and save it periodically and at exit\n"
+        << "  -S <seconds>      minimum time between two saves of the state (default: 300, 0 for every snapshot)\n"
+        << "  -f <format>       format of the snapshots: bin (default) or csv\n"
+        << "  -w <width>        size in bytes of the binary component map entries: 4 (default) or 8\n"
+        << "  -t <num_threads>  number of threads writing the CSV snapshots (default: number of hardware threads)\n";
+}
+
+/**
+ * @brief Writes a snapshot of the clustering, atomically replacing the previous one
+ *
+ * @param path path of the snapshot
+ * @param parent the union-find forest
+ * @param format format of the snapshot
+ * @param width size of the entries of a binary snapshot
+ * @param num_threads number of threads writing a CSV snapshot
+ * @param num_cc receives the number of components
+ * @return true on success, false on error
+ */
+bool write_snapshot(const string &path, const comp_map_t &parent, output_format_t format, uint32_t width,
+    int num_threads, uint32_t *num_cc) {
+    comp_map_t comp_map = parent;
+    *num_cc = uf_finish(comp_map);
+    string tmp_path = path + ".tmp";
+    int fd = open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    bool written = (format == FORMAT_CSV) ? write_csv(fd, comp_map, num_threads) :
+        write_comp_map_binary(fd, comp_map, *num_cc, width);
+    if (close(fd) != 0 || !written) {
+        unlink(tmp_path.c_str());
+        return false;
+    }
+    return rename(tmp_path.c_str(), path.c_str()) == 0;
+}
+
+int main(int argc, char **argv) {
+    const char *input_path = NULL;
+    bool keep_open = false;
+    long latency_ms = 1000;
+    const char *state_path = NULL;
+    double state_sec = 300;
+    output_format_t format = FORMAT_BIN;
+    uint32_t map_width = sizeof(uint32_t);
+    int num_threads = default_num_threads();
+    int opt;
+    while ((opt = getopt(argc, argv, "f:i:kl:S:s:t:w:")) != -1) {
+        switch (opt) {
+            case 'f':
+                if (!strcmp(optarg, "csv")) format = FORMAT_CSV;
+                else if (!strcmp(optarg, "bin")) format = FORMAT_BIN;
+                else {
+                    cerr << "Error: unknown snapshot format " << optarg << "!\n";
+                    return 1;
+                }
+                break;
+            case 'i':
+                input_path = optarg;
+                break;
+            case 'k':
+                keep_open = true;
+                break;
+            case 'l':
+                latency_ms = atol(optarg);
+                if (latency_ms < 0) {
+                    cerr << "Error: the latency must be non-negative!\n";
+                    return 1;
+                }
+                break;
+            case 'S':
+                state_sec = atof(optarg);
+                if (state_sec < 0) {
+                    cerr << "Error: the interval between two saves of the state must be non-negative!\n";
+                    return 1;
+                }
+                break;
+            case 's':
+                state_path = optarg;
+                break;
+            case 't':
+                num_threads = atoi(optarg);
+                if (num_threads < 1) {
+                    cerr << "Error: the number of threads must be positive!\n";
+                    return 1;
+                }
+                break;
+            case 'w':
+                map_width = atoi(optarg);
+                if (map_width != sizeof(uint32_t) && map_width != sizeof(uint64_t)) {
+                    cerr << "Error: the entry size must be 4 or 8!\n";
+                    return 1;
+                }
+                break;
+            default:
+                print_usage(argv[0]);
+                return 1;
+        }
+    }
+    if (argc - optind < 1) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    string snapshot_path = argv[optind];
+
+    auto start = high_resolution_clock::now();
+
+    // Load the initial state, if any.
+    uf_state_t state;
+    uf_state_init(&state);
+    if (state_path) {
+        FILE *state_file = fopen(state_path, "rb");
+        if (state_file) {
+            bool valid = read_uf_state(state_file, &state);
+            fclose(state_file);
+            if (!valid) {
+                cerr << "Error: could not read the state file!\n";
+                return 1;
+            }
+        }
+        else if (errno != ENOENT) {
+            cerr << "Error: could not open state file!\n";
+            return 1;
+        }
+    }
+
+    // Open the input.
+    int input_fd = input_path ? open(input_path, O_RDONLY) : STDIN_FILENO;
+    if (input_fd < 0) {
+        cerr << "Error: could not open input file!\n";
+        return 1;
+    }
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = handle_stop;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    // Read the input in blocks, processing each complete line as soon as it is available.
+    // Partial lines are kept at the beginning of the buffer until the rest arrives.
+    vector<char> buf(STREAM_READ_SIZE + 1);
+    size_t buf_len = 0;
+    edge_list_t edges;
+    vector<uint32_t> endpoints;
+    uint64_t num_tx = 0, num_snapshots = 0;
+    uint32_t num_cc = 0;
+    bool dirty = false, state_dirty = false, input_open = true;
+    steady_clock::time_point deadline, last_state_save = steady_clock::now();
+    auto state_interval = duration<double>(state_sec);
+    auto process = [&](char *line) {
+        process_line(line, &state.max_id, edges);
+        uf_grow(state.parent, state.max_id + 1);
+        endpoints.resize(2 * edges.size());
+        for (size_t i = 0; i < edges.size(); i++) {
+            endpoints[2*i] = edges[i].first;
+            endpoints[2*i+1] = edges[i].second;
+        }
+        uf_union_edges(state.parent.data(), endpoints.data(), edges.size(), 0);
+        edges.clear();
+        state.num_tx++;
+        num_tx++;
+        state_dirty = true;
+        // The first change after a snapshot sets the deadline of the next one.
+        if (!dirty) {
+            dirty = true;
+            deadline = steady_clock::now() + milliseconds(latency_ms);
+        }
+    };
+    auto save_state = [&]() {
+        if (!write_uf_state(state_path, &state)) {
+            cerr << "Error: could not write the state file!\n";
+            return false;
+        }
+        state_dirty = false;
+        last_state_save = steady_clock::now();
+        return true;
+    };
+    auto snapshot = [&]() {
+        if (!write_snapshot(snapshot_path, state.parent, format, map_width, num_threads, &num_cc)) {
+            cerr << "Error: could not write the snapshot!\n";
+            return false;
+        }
+        num_snapshots++;
+        dirty = false;
+        // The state is only saved once the interval has elapsed.
+        if (state_path && state_dirty && steady_clock::now() - last_state_save >= state_interval) return save_state();
+        return true;
+    };
+    while (input_open && !stop_requested) {
+        // Wait for new input, but no longer than the deadline of the pending snapshot.
+        int timeout = -1;
+        if (dirty) {
+            auto left = duration_cast<milliseconds>(deadline - steady_clock::now()).count();
+            timeout = (left > 0) ? left : 0;
+        }
+        struct pollfd pfd = {input_fd, POLLIN, 0};
+        int ready = poll(&pfd, 1, timeout);
+        if (ready < 0 && errno != EINTR) {
+            cerr << "Error: could not poll the input!\n";
+            return 1;
+        }
+        if (ready > 0) {
+            if (buf.size() - buf_len < STREAM_READ_SIZE + 1) buf.resize(buf_len + STREAM_READ_SIZE + 1);
+            ssize_t n = read(input_fd, buf.data() + buf_len, STREAM_READ_SIZE);
+            if (n < 0 && errno != EINTR && errno != EAGAIN) {
+                cerr << "Error: could not read the input!\n";
+                return 1;
+            }
+            if (n > 0) {
+                // Process the complete lines and move the partial one to the beginning.
+                size_t line_start = 0, end = buf_len + n;
+                for (size_t i = buf_len; i < end; i++) {
+                    if (buf[i] != '\n') continue;
+                    buf[i] = '\0';
+                    process(buf.data() + line_start);
+                    line_start = i + 1;
+                }
+                buf_len = end - line_start;
+                memmove(buf.data(), buf.data() + line_start, buf_len);
+            }
+            else if (n == 0) {
+                // All writers are gone: process the last line, publish the snapshot
+                // and, if requested, wait for a new writer of the named pipe.
+                if (buf_len > 0) {
+                    buf[buf_len] = '\0';
+                    process(buf.data());
+                    buf_len = 0;
+                }
+                if (dirty && !snapshot()) return 1;
+                input_open = false;
+                if (keep_open && input_path) {
+                    close(input_fd);
+                    input_fd = open(input_path, O_RDONLY);
+                    input_open = (input_fd >= 0);
+                }
+            }
+        }
+        if (dirty && steady_clock::now() >= deadline && !snapshot()) return 1;
+    }
+    // Publish the last changes, e.g., after a signal, and save the state.
+    if (dirty && !snapshot()) return 1;
+    if (state_path && state_dirty && !save_state()) return 1;
+
+    auto end = high_resolution_clock::now();
+    auto elapsed = duration_cast<nanoseconds>(end - start);
+
+    // Print the number of nodes, the number of transactions processed,
+    // the number of snapshots, the number of components in the last
+    // snapshot and the elapsed time in nanoseconds.
+    cout << state.parent.size() << '\t' << num_tx << '\t' << num_snapshots << '\t' << num_cc << '\t'
+        << elapsed.count() << '\n';
+    return 0;
+}
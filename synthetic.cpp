@@ -0,0 +1,74 @@
+/**
+ * @file synthetic.cpp
+ * @author Matteo Loporchio
+ * @brief Generator of synthetic transaction files in the format read by the builder
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#include "synthetic.hpp"
+#include "output.hpp"
+
+using namespace std;
+
+/// @brief Number of recent addresses from which half of the inputs are drawn
+#define SYNTHETIC_RECENT_ADDRESSES (1 << 16)
+
+/// @brief Distribution of the number of inputs of a transaction
+static const int chain_num_inputs[] = {0, 1, 1, 1, 1, 1, 1, 2, 2, 3, 5, 20};
+
+/// @brief Distribution of the number of outputs of a transaction
+static const int chain_num_outputs[] = {1, 2, 2, 2, 3};
+
+void chain_init(chain_generator_t *chain, uint64_t seed) {
+    chain->gen.seed(seed);
+    chain->num_tx = 0;
+    chain->num_addresses = 0;
+}
+
+/**
+ * @brief Draws an existing address (at least one must exist)
+ *
+ * @param chain the generator
+ */
+static uint32_t existing_address(chain_generator_t *chain) {
+    uint64_t r = chain->gen();
+    uint64_t range = chain->num_addresses;
+    if ((r & 1) && range > SYNTHETIC_RECENT_ADDRESSES) {
+        return chain->num_addresses - 1 - (r >> 1) % SYNTHETIC_RECENT_ADDRESSES;
+    }
+    return (r >> 1) % range;
+}
+
+size_t chain_next(chain_generator_t *chain, char *line) {
+    char *p = line;
+    p += format_uint32(p, chain->num_tx);
+    *p++ = ':';
+    // Inputs: address, previous transaction and output index.
+    int k = (chain->num_addresses == 0) ? 0 :
+        chain_num_inputs[chain->gen() % (sizeof(chain_num_inputs) / sizeof(int))];
+    for (int i = 0; i < k; i++) {
+        if (i > 0) *p++ = ';';
+        p += format_uint32(p, existing_address(chain));
+        *p++ = ',';
+        p += format_uint32(p, chain->gen() % chain->num_tx);
+        *p++ = ',';
+        p += format_uint32(p, chain->gen() % 4);
+    }
+    *p++ = ':';
+    // Outputs: address (usually a new one) and amount.
+    k = chain_num_outputs[chain->gen() % (sizeof(chain_num_outputs) / sizeof(int))];
+    for (int i = 0; i < k; i++) {
+        if (i > 0) *p++ = ';';
+        uint64_t r = chain->gen();
+        uint32_t address = (chain->num_addresses == 0 || r % 4 != 0) ? chain->num_addresses++ : existing_address(chain);
+        p += format_uint32(p, address);
+        *p++ = ',';
+        p += format_uint32(p, (r >> 8) % 100000000);
+    }
+    *p++ = '\n';
+    chain->num_tx++;
+    return p - line;
+}
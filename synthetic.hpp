@@ -0,0 +1,55 @@
+/**
+ * @file synthetic.hpp
+ * @author Matteo Loporchio
+ * @brief Generator of synthetic transaction files in the format read by the builder
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * The generator produces a chain of transactions one line at a time, so
+ * inputs of any size can be streamed to a file. Addresses are created by the
+ * outputs of the transactions and later spent by their inputs, which are
+ * drawn partly from the most recent addresses and partly from the whole
+ * history. The number of inputs and outputs follows a skewed distribution
+ * (most transactions have one input and one or two outputs), and a few
+ * transactions have no inputs (like coinbase transactions).
+ *
+ * The output is deterministic for a given seed.
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#ifndef SYNTHETIC_HPP
+#define SYNTHETIC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+/// @brief Maximum length of a generated line, including the newline
+#define SYNTHETIC_MAX_LINE 1024
+
+/// @brief State of the generator
+typedef struct {
+    std::mt19937_64 gen;        ///< random number generator
+    uint64_t num_tx;            ///< number of transactions generated so far
+    uint64_t num_addresses;     ///< number of addresses created so far
+} chain_generator_t;
+
+/**
+ * @brief Initializes the generator
+ *
+ * @param chain the generator
+ * @param seed seed of the random number generator
+ */
+void chain_init(chain_generator_t *chain, uint64_t seed);
+
+/**
+ * @brief Generates the next transaction
+ *
+ * @param chain the generator
+ * @param line buffer of at least SYNTHETIC_MAX_LINE characters, receiving the line (not NUL-terminated)
+ * @return the length of the line, including the final newline
+ */
+size_t chain_next(chain_generator_t *chain, char *line);
+
+#endif
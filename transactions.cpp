@@ -0,0 +1,66 @@
+/**
+ * @file transactions.cpp
+ * @author Matteo Loporchio
+ * @brief Parser of the textual transaction files read by the builder
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#include "transactions.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+
+void process_inputs(char *inputs, int *max_id, edge_list_t &edges) {
+    char *ptr = inputs, *save_ptr;
+    // Obtain the first input address.
+    char *input = strtok_r(ptr, ";", &save_ptr);
+    int first_address = atoi(strtok(input, ","));
+    if (first_address >= *max_id) *max_id = first_address;
+    // Iterate trough all remaining inputs.
+    int curr_address;
+    while ((input = strtok_r(NULL, ";", &save_ptr))) {
+        // Extract the current address.
+        curr_address = atoi(strtok(input, ","));
+        // Skip this address if it is equal to the first one.
+        if (curr_address == first_address) continue;
+        // Create the new edge.
+        edges.push_back(minmax(first_address, curr_address));
+        // Update the maximum identifier, if necessary.
+        if (curr_address >= *max_id) *max_id = curr_address;
+    }
+}
+
+void process_outputs(char *outputs, int *max_id, edge_list_t &edges) {
+    char *ptr, *save_ptr, *output_str, *address_str;
+    int address;
+    for (ptr = outputs; ; ptr = NULL) {
+        if (!(output_str = strtok_r(ptr, ";", &save_ptr))) break;
+        // The first field of the output corresponds to the address.
+        address_str = strtok(output_str, ",");
+        address = atoi(address_str);
+        // Update the maximum identifier, if necessary.
+        if (address >= *max_id) *max_id = address;
+    }
+}
+
+void process_line(char *line_buf, int *max_id, edge_list_t &edges) {
+    char *token = NULL;
+    int token_count = 0;
+    while ((token = strsep(&line_buf, ":"))) {
+        if (token_count == 1) {
+            // Processing inputs
+            if (token[0] != '\0') process_inputs(token, max_id, edges);
+        }
+        if (token_count == 2) {
+            // Processing outputs
+            if (token[0] != '\0') process_outputs(token, max_id, edges);
+        }
+        token_count++;
+    }
+}
@@ -0,0 +1,52 @@
+/**
+ * @file transactions.hpp
+ * @author Matteo Loporchio
+ * @brief Parser of the textual transaction files read by the builder
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Each line of the input file represents a transaction, made of
+ * colon-separated fields: the second field lists the inputs and the third
+ * one the outputs, both as semicolon-separated entries whose first
+ * comma-separated field is an address identifier. Parsing a transaction
+ * adds to the edge list a path among its input addresses (multi-input heuristic).
+ * See https://zenodo.org/record/7696454#.ZBOmgy9abq0 for the complete format.
+ *
+ * The parser modifies the line in place.
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#ifndef TRANSACTIONS_HPP
+#define TRANSACTIONS_HPP
+
+#include "graph_file.hpp"
+
+/**
+ * @brief Processes the list of transaction inputs (represented as a semicolon-separated string)
+ * 
+ * @param inputs string containing all transaction inputs
+ * @param max_id maximum address identifier seen while parsing transactions
+ * @param edges list of graph edges
+ */
+void process_inputs(char *inputs, int *max_id, edge_list_t &edges);
+
+/**
+ * @brief Processes the list of transaction outputs (represented as a semicolon-separated string)
+ * 
+ * @param outputs string containing all transaction outputs
+ * @param max_id maximum address identifier seen while parsing transactions
+ * @param edges list of graph edges 
+ */
+void process_outputs(char *outputs, int *max_id, edge_list_t &edges);
+
+/**
+ * @brief Processes a single line of the input file (i.e., a transaction)
+ * 
+ * @param line_buf buffer containing the line
+ * @param max_id maximum address identifier seen while parsing transactions
+ * @param edges list of graph edges
+ */
+void process_line(char *line_buf, int *max_id, edge_list_t &edges);
+
+#endif
@@ -0,0 +1,66 @@
+/**
+ * @file uf_state.cpp
+ * @author Matteo Loporchio
+ * @brief Persistent union-find state for incremental clustering
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#include "uf_state.hpp"
+
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+using namespace std;
+
+void uf_state_init(uf_state_t *state) {
+    uf_init(state->parent, 1);
+    state->max_id = 0;
+    state->num_tx = 0;
+    state->input_offset = 0;
+}
+
+bool read_uf_state(FILE *state_file, uf_state_t *state) {
+    uf_state_header_t header;
+    if (fread(&header, sizeof(header), 1, state_file) != 1) return false;
+    if (memcmp(header.magic, UF_STATE_MAGIC, sizeof(header.magic)) != 0) return false;
+    if (header.version != UF_STATE_VERSION || header.max_id < 0) return false;
+    if (header.num_nodes != (uint64_t) header.max_id + 1) return false;
+    state->parent.resize(header.num_nodes);
+    if (fread(state->parent.data(), sizeof(uint32_t), header.num_nodes, state_file) != header.num_nodes) {
+        return false;
+    }
+    // Every non-root entry must point to a node of the forest.
+    for (uint32_t p : state->parent) {
+        if (!(p & UF_ROOT) && p >= header.num_nodes) return false;
+    }
+    state->max_id = header.max_id;
+    state->num_tx = header.num_tx;
+    state->input_offset = header.input_offset;
+    return true;
+}
+
+bool write_uf_state(const char *path, const uf_state_t *state) {
+    uf_state_header_t header;
+    memcpy(header.magic, UF_STATE_MAGIC, sizeof(header.magic));
+    header.version = UF_STATE_VERSION;
+    header.max_id = state->max_id;
+    header.num_nodes = state->parent.size();
+    header.num_tx = state->num_tx;
+    header.input_offset = state->input_offset;
+    // Write to a temporary file, flushed to disk before it replaces the previous state.
+    string tmp_path = string(path) + ".tmp";
+    FILE *state_file = fopen(tmp_path.c_str(), "wb");
+    if (!state_file) return false;
+    bool written = fwrite(&header, sizeof(header), 1, state_file) == 1 &&
+        fwrite(state->parent.data(), sizeof(uint32_t), state->parent.size(), state_file) == state->parent.size() &&
+        fflush(state_file) == 0 && fsync(fileno(state_file)) == 0;
+    if (fclose(state_file) != 0 || !written) {
+        unlink(tmp_path.c_str());
+        return false;
+    }
+    return rename(tmp_path.c_str(), path) == 0;
+}
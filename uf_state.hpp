@@ -0,0 +1,81 @@
+/**
+ * @file uf_state.hpp
+ * @author Matteo Loporchio
+ * @brief Persistent union-find state for incremental clustering
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * A state file contains a 40-byte header (see uf_state_header_t) followed by
+ * the sequential union-find forest over all the addresses seen so far
+ * (see uf_init()): one 32-bit entry per node, in the native byte order
+ * of the machine that wrote the file. Roots hold the size of their tree,
+ * while the other nodes hold their parent. The header also records how much
+ * of the transaction file has been processed, so that a later run can
+ * resume from there and only parse the transactions appended in the meantime.
+ *
+ * States are saved to a temporary file that is then renamed over the
+ * previous one, so an interrupted run never leaves a corrupted state behind.
+ *
+ * @copyright Copyright (c) 2023 Matteo Loporchio
+ */
+
+#ifndef UF_STATE_HPP
+#define UF_STATE_HPP
+
+#include <cstdint>
+#include <cstdio>
+
+#include "components.hpp"
+
+/// @brief Magic string at the beginning of a union-find state file
+#define UF_STATE_MAGIC "UFSTATE\0"
+
+/// @brief Current version of the union-find state format
+#define UF_STATE_VERSION 1
+
+/// @brief Header of a union-find state file
+typedef struct {
+    char magic[8];              ///< UF_STATE_MAGIC
+    uint32_t version;           ///< UF_STATE_VERSION
+    int32_t max_id;             ///< maximum address identifier seen so far
+    uint64_t num_nodes;         ///< number of entries of the forest (max_id + 1)
+    uint64_t num_tx;            ///< number of transactions processed so far
+    uint64_t input_offset;      ///< number of bytes of the transaction file processed so far
+} uf_state_header_t;
+
+/// @brief Union-find state kept across runs
+typedef struct {
+    comp_map_t parent;          ///< the union-find forest
+    int max_id;                 ///< maximum address identifier seen so far
+    uint64_t num_tx;            ///< number of transactions processed so far
+    uint64_t input_offset;      ///< number of bytes of the transaction file processed so far
+} uf_state_t;
+
+/**
+ * @brief Initializes an empty state, as if no transaction had been processed
+ *
+ * Like the builder, the state always contains at least node 0.
+ *
+ * @param state the state
+ */
+void uf_state_init(uf_state_t *state);
+
+/**
+ * @brief Reads a state file
+ *
+ * @param state_file pointer to the (already opened) state file
+ * @param state receives the state
+ * @return true on success, false if the file is truncated or not a valid state
+ */
+bool read_uf_state(FILE *state_file, uf_state_t *state);
+
+/**
+ * @brief Writes a state file, atomically replacing the previous one
+ *
+ * @param path path of the state file
+ * @param state the state
+ * @return true on success, false on error (the previous state is then left untouched)
+ */
+bool write_uf_state(const char *path, const uf_state_t *state);
+
+#endif